@@ -40,6 +40,17 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 	Resources.Sort(SortByResourceType);
 	ConsumerResources.Sort(SortByResourceType);
 	MaintenanceResources.Sort(SortByResourceType);
+
+	// Resources are indexed by their position in the sorted catalog
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		Resources[Index]->Data.Index = Index;
+
+		if (!ResourceIndex.Contains(Resources[Index]->Data.Identifier))
+		{
+			ResourceIndex.Add(Resources[Index]->Data.Identifier, Resources[Index]);
+		}
+	}
 }
 
 
@@ -49,28 +60,15 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 
 FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareResourceCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareResourceCatalogEntry* const* Entry = Resources.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	return NULL;
+	UFlareResourceCatalogEntry* Entry = ResourceIndex.FindRef(Identifier);
+	return Entry ? &Entry->Data : NULL;
 }
 
 UFlareResourceCatalogEntry* UFlareResourceCatalog::GetEntry(FFlareResourceDescription* Resource) const
 {
-	for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+	if (Resource && Resources.IsValidIndex(Resource->Index) && Resource == &Resources[Resource->Index]->Data)
 	{
-		if(Resource == &Resources[ResourceIndex]->Data)
-		{
-			return Resources[ResourceIndex];
-		}
+		return Resources[Resource->Index];
 	}
 	return NULL;
 }
@@ -45,6 +45,16 @@ public:
 		return Resources;
 	}
 
+
+protected:
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Resources by identifier, built once at load */
+	TMap<FName, UFlareResourceCatalogEntry*> ResourceIndex;
+
 };
 
 inline static bool SortByResourceType(const UFlareResourceCatalogEntry& ResourceA, const UFlareResourceCatalogEntry& ResourceB)
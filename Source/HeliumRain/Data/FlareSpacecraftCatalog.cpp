@@ -86,6 +86,22 @@ UFlareSpacecraftCatalog::UFlareSpacecraftCatalog(const class FObjectInitializer&
 
 	StationCatalog.Sort(FSortByEntrySize());
 	ShipCatalog.Sort(FSortByEntrySize());
+
+	// Index ships first, then stations
+	for (UFlareSpacecraftCatalogEntry* Entry : ShipCatalog)
+	{
+		if (!SpacecraftIndex.Contains(Entry->Data.Identifier))
+		{
+			SpacecraftIndex.Add(Entry->Data.Identifier, Entry);
+		}
+	}
+	for (UFlareSpacecraftCatalogEntry* Entry : StationCatalog)
+	{
+		if (!SpacecraftIndex.Contains(Entry->Data.Identifier))
+		{
+			SpacecraftIndex.Add(Entry->Data.Identifier, Entry);
+		}
+	}
 }
 
 
@@ -95,23 +111,7 @@ UFlareSpacecraftCatalog::UFlareSpacecraftCatalog(const class FObjectInitializer&
 
 FFlareSpacecraftDescription* UFlareSpacecraftCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareSpacecraftCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftCatalogEntry* const* Entry = ShipCatalog.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	Entry = StationCatalog.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	return NULL;
+	UFlareSpacecraftCatalogEntry* Entry = SpacecraftIndex.FindRef(Identifier);
+	return Entry ? &Entry->Data : NULL;
 }
 
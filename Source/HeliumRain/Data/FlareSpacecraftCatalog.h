@@ -34,4 +34,13 @@ public:
 	FFlareSpacecraftDescription* Get(FName Identifier) const;
 
 
+protected:
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Ships and stations by identifier, built once at load */
+	TMap<FName, UFlareSpacecraftCatalogEntry*> SpacecraftIndex;
+
 };
@@ -75,6 +75,19 @@ UFlareSpacecraftComponentsCatalog::UFlareSpacecraftComponentsCatalog(const class
 	EngineCatalog.Sort(SortByCost);
 	RCSCatalog.Sort(SortByCost);
 	WeaponCatalog.Sort(SortByWeaponType);
+
+	// Index all parts, the first entry of an identifier wins like it used to with sequential searches
+	TArray<UFlareSpacecraftComponentsCatalogEntry*>* Catalogs[] = { &EngineCatalog, &RCSCatalog, &WeaponCatalog, &InternalComponentsCatalog, &MetaCatalog };
+	for (TArray<UFlareSpacecraftComponentsCatalogEntry*>* Catalog : Catalogs)
+	{
+		for (UFlareSpacecraftComponentsCatalogEntry* Entry : *Catalog)
+		{
+			if (Entry && !ComponentIndex.Contains(Entry->Data.Identifier))
+			{
+				ComponentIndex.Add(Entry->Data.Identifier, Entry);
+			}
+		}
+	}
 }
 
 
@@ -84,56 +97,8 @@ UFlareSpacecraftComponentsCatalog::UFlareSpacecraftComponentsCatalog(const class
 
 FFlareSpacecraftComponentDescription* UFlareSpacecraftComponentsCatalog::Get(FName Identifier) const
 {
-	FFlareSpacecraftComponentDescription* Part = NULL;
-
-	auto FindByName = [=](const UFlareSpacecraftComponentsCatalogEntry* Candidate)
-	{
-		return Candidate && Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftComponentsCatalogEntry* const* Temp = EngineCatalog.FindByPredicate(FindByName);
-	if (Temp)
-	{
-		Part = &(*Temp)->Data;
-	}
-
-	if (!Part)
-	{
-		Temp = RCSCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-
-	if (!Part)
-	{
-		Temp = WeaponCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-
-	if (!Part)
-	{
-		Temp = InternalComponentsCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-	
-	if (!Part)
-	{
-		Temp = MetaCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-
-	return Part;
+	UFlareSpacecraftComponentsCatalogEntry* Entry = ComponentIndex.FindRef(Identifier);
+	return Entry ? &Entry->Data : NULL;
 }
 
 const void UFlareSpacecraftComponentsCatalog::GetEngineList(TArray<FFlareSpacecraftComponentDescription*>& OutData, TEnumAsByte<EFlarePartSize::Type> Size, UFlareCompany* FilterCompany)
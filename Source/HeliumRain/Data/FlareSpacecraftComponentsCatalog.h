@@ -54,4 +54,13 @@ public:
 	const void GetWeaponList(TArray<FFlareSpacecraftComponentDescription*>& OutData, TEnumAsByte<EFlarePartSize::Type> Size, UFlareCompany* FilterCompany = NULL);
 
 
+protected:
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Parts of all types by identifier, built once at load */
+	TMap<FName, UFlareSpacecraftComponentsCatalogEntry*> ComponentIndex;
+
 };
@@ -23,6 +23,11 @@ UFlareTechnologyCatalog::UFlareTechnologyCatalog(const class FObjectInitializer&
 		UFlareTechnologyCatalogEntry* Technology = Cast<UFlareTechnologyCatalogEntry>(AssetList[Index].GetAsset());
 		FCHECK(Technology);
 		TechnologyCatalog.Add(Technology);
+
+		if (!TechnologyIndex.Contains(Technology->Data.Identifier))
+		{
+			TechnologyIndex.Add(Technology->Data.Identifier, Technology);
+		}
 	}
 }
 
@@ -33,17 +38,7 @@ UFlareTechnologyCatalog::UFlareTechnologyCatalog(const class FObjectInitializer&
 
 FFlareTechnologyDescription* UFlareTechnologyCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareTechnologyCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareTechnologyCatalogEntry* const* Entry = TechnologyCatalog.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	return NULL;
+	UFlareTechnologyCatalogEntry* Entry = TechnologyIndex.FindRef(Identifier);
+	return Entry ? &Entry->Data : NULL;
 }
 
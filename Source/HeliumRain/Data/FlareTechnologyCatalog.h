@@ -26,8 +26,17 @@ public:
 		Public methods
 	----------------------------------------------------*/
 	
-	/** Get a ship from identifier */
+	/** Get a technology from identifier */
 	FFlareTechnologyDescription* Get(FName Identifier) const;
 
 
+protected:
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Technologies by identifier, built once at load */
+	TMap<FName, UFlareTechnologyCatalogEntry*> TechnologyIndex;
+
 };
@@ -197,6 +197,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		int32 TakenQuantity = FMath::Min(MinQuantityCargo->Quantity, QuantityToTake);
 		if (TakenQuantity > 0)
 		{
+			Parent->MarkSaveDirty();
 			MinQuantityCargo->Quantity -= TakenQuantity;
 			QuantityToTake -= TakenQuantity;
 
@@ -226,6 +227,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			int32 TakenQuantity = FMath::Min(Cargo.Quantity, QuantityToTake);
 			if (TakenQuantity > 0)
 			{
+				Parent->MarkSaveDirty();
 				Cargo.Quantity -= TakenQuantity;
 				QuantityToTake -= TakenQuantity;
 
@@ -244,12 +246,20 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 	return Quantity - QuantityToTake;
 }
 
-void UFlareCargoBay::DumpCargo(FFlareCargo* Cargo)
+void UFlareCargoBay::DumpCargo(int32 SlotIndex)
 {
-	Cargo->Quantity = 0;
-	if (Cargo->Lock == EFlareResourceLock::NoLock)
+	if (!CargoBay.IsValidIndex(SlotIndex))
 	{
-		Cargo->Resource = NULL;
+		return;
+	}
+
+	Parent->MarkSaveDirty();
+
+	FFlareCargo& Cargo = CargoBay[SlotIndex];
+	Cargo.Quantity = 0;
+	if (Cargo.Lock == EFlareResourceLock::NoLock)
+	{
+		Cargo.Resource = NULL;
 	}
 }
 
@@ -278,6 +288,7 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(AvailableCapacity, QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				Parent->MarkSaveDirty();
 				Cargo.Quantity += GivenQuantity;
 				QuantityToGive -= GivenQuantity;
 
@@ -304,6 +315,7 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(GetSlotCapacity(), QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				Parent->MarkSaveDirty();
 				Cargo.Quantity += GivenQuantity;
 				Cargo.Resource = Resource;
 
@@ -436,7 +448,7 @@ int32 UFlareCargoBay::GetSlotCount() const
 	return CargoBayCount;
 }
 
-FFlareCargo* UFlareCargoBay::GetSlot(int32 Index)
+const FFlareCargo* UFlareCargoBay::GetSlot(int32 Index) const
 {
 	if(Index >= CargoBay.Num())
 	{
@@ -458,6 +470,7 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 
 		if (Cargo.Lock == EFlareResourceLock::NoLock && (Cargo.Resource == NULL || Cargo.Resource == Resource))
 		{
+			Parent->MarkSaveDirty();
 			Cargo.Lock = LockType;
 			Cargo.ManualLock = ManualLock;
 
@@ -486,6 +499,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 				continue;
 			}
 
+			Parent->MarkSaveDirty();
 			Cargo.Lock = EFlareResourceLock::NoLock;
 			Cargo.ManualLock = false;
 
@@ -503,6 +517,8 @@ void UFlareCargoBay::SetSlotRestriction(int32 SlotIndex, EFlareResourceRestricti
 	{
 		FLOGV("Invalid index %d for set slot restriction (cargo bay size: %d)", SlotIndex, CargoBay.Num());
 	}
+
+	Parent->MarkSaveDirty();
 	CargoBay[SlotIndex].Restriction = RestrictionType;
 }
 
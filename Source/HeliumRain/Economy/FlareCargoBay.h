@@ -39,7 +39,7 @@ public:
 	/* If client is not null, restriction are used*/
 	int32 TakeResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client);
 
-	void DumpCargo(FFlareCargo* Cargo);
+	void DumpCargo(int32 SlotIndex);
 
 	/* If client is not null, restriction are used*/
 	int32 GiveResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client);
@@ -92,7 +92,7 @@ public:
 
 	bool HasRestrictions() const;
 
-	FFlareCargo* GetSlot(int32 Index);
+	const FFlareCargo* GetSlot(int32 Index) const;
 
 	TArray<FFlareCargo>& GetSlots()
 	{
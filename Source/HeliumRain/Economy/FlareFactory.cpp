@@ -6,6 +6,7 @@
 #include "../Data/FlareSpacecraftCatalog.h"
 
 #include "../Game/FlareWorld.h"
+#include "../Game/FlareWorldHelper.h"
 #include "../Game/FlareGame.h"
 #include "../Game/FlareGameTools.h"
 #include "../Game/FlareCompany.h"
@@ -78,6 +79,7 @@ void UFlareFactory::Simulate()
 
 		if (FactoryData.ProductedDuration < GetProductionTime(GetCycleData()))
 		{
+			Parent->MarkSaveDirty();
 			FactoryData.ProductedDuration += 1;
 		}
 
@@ -152,13 +154,16 @@ void UFlareFactory::Start()
 		}
 	}
 
+	Parent->MarkSaveDirty();
 	FactoryData.Active = true;
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(Parent->GetCurrentSector());
 }
 
 void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 {
 	if (FactoryData.TargetShipCompany == NAME_None && Order.Company != NAME_None)
 	{
+		Parent->MarkSaveDirty();
 		FactoryData.TargetShipClass = Order.ShipClass;
 		FactoryData.TargetShipCompany = Order.Company;
 		FactoryData.ProductedDuration = 0;
@@ -171,27 +176,39 @@ void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 
 void UFlareFactory::Pause()
 {
+	Parent->MarkSaveDirty();
+
 	FactoryData.Active = false;
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(Parent->GetCurrentSector());
 }
 
 void UFlareFactory::Stop()
 {
+	Parent->MarkSaveDirty();
+
 	FactoryData.Active = false;
 	CancelProduction();
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(Parent->GetCurrentSector());
 }
 
 void UFlareFactory::SetInfiniteCycle(bool Mode)
 {
+	Parent->MarkSaveDirty();
+
 	FactoryData.InfiniteCycle = Mode;
 }
 
 void UFlareFactory::SetCycleCount(uint32 Count)
 {
+	Parent->MarkSaveDirty();
+
 	FactoryData.CycleCount = Count;
 }
 
 void UFlareFactory::SetOutputLimit(FFlareResourceDescription* Resource, uint32 MaxSlot)
 {
+	Parent->MarkSaveDirty();
+
 	bool ExistingResource = false;
 	for (int32 CargoLimitIndex = 0 ; CargoLimitIndex < FactoryData.OutputCargoLimit.Num() ; CargoLimitIndex++)
 	{
@@ -218,6 +235,7 @@ void UFlareFactory::ClearOutputLimit(FFlareResourceDescription* Resource)
 	{
 		if (FactoryData.OutputCargoLimit[CargoLimitIndex].ResourceIdentifier == Resource->Identifier)
 		{
+			Parent->MarkSaveDirty();
 			FactoryData.OutputCargoLimit.RemoveAt(CargoLimitIndex);
 			return;
 		}
@@ -354,6 +372,7 @@ void UFlareFactory::BeginProduction()
 		return;
 	}
 
+	Parent->MarkSaveDirty();
 
 	// Consume input resources
 	for (int32 ResourceIndex = 0 ; ResourceIndex < GetCycleData().InputResources.Num() ; ResourceIndex++)
@@ -407,6 +426,8 @@ void UFlareFactory::BeginProduction()
 
 void UFlareFactory::CancelProduction()
 {
+	Parent->MarkSaveDirty();
+
 	Parent->GetCompany()->GiveMoney(FactoryData.CostReserved);
 	FactoryData.CostReserved = 0;
 
@@ -441,6 +462,8 @@ void UFlareFactory::CancelProduction()
 
 void UFlareFactory::DoProduction()
 {
+	Parent->MarkSaveDirty();
+
 	// Pay cost
 	uint32 PaidCost = FMath::Min(GetProductionCost(), FactoryData.CostReserved);
 	FactoryData.CostReserved -= PaidCost;
@@ -767,7 +790,7 @@ const FFlareProductionData& UFlareFactory::GetCycleData()
 	{
 		return GetCycleDataForShipClass(FactoryData.TargetShipClass);
 	}
-	else if (Parent->GetLevel() == CycleCostCacheLevel)
+	else if ((Parent->IsUnderConstruction() ? 1 : Parent->GetLevel()) == CycleCostCacheLevel)
 	{
 		return CycleCostCache;
 	}
@@ -83,6 +83,7 @@ void UFlarePeople::Simulate()
 		return;
 	}
 
+	Parent->MarkSaveDirty();
 
 	SimulateResourcePurchase();
 
@@ -412,6 +413,7 @@ uint32 UFlarePeople::BuyInStationForCompany(FFlareResourceDescription* Resource,
 		uint32 TakenQuantity = BestStation->GetCargoBay()->TakeResources(Resource, RemainingQuantity, NULL);
 		RemainingQuantity -= TakenQuantity;
 		uint32 Price = (uint32) (ResourcePrice) * TakenQuantity;
+		Parent->MarkSaveDirty();
 		PeopleData.Money -= Price;
 		Company->GiveMoney(Price);
 
@@ -436,6 +438,7 @@ float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource,
 	{
 		if (PeopleData.FoodConsumption < FOOD_MIN_CONSUMPTION)
 		{
+			Parent->MarkSaveDirty();
 			PeopleData.FoodConsumption = FOOD_MIN_CONSUMPTION;
 		}
 
@@ -455,6 +458,7 @@ float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource,
 	{
 		if (PeopleData.FuelConsumption < FUEL_MIN_CONSUMPTION)
 		{
+			Parent->MarkSaveDirty();
 			PeopleData.FuelConsumption = FUEL_MIN_CONSUMPTION;
 		}
 
@@ -474,6 +478,7 @@ float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource,
 	{
 		if (PeopleData.ToolConsumption < TOOL_MIN_CONSUMPTION)
 		{
+			Parent->MarkSaveDirty();
 			PeopleData.ToolConsumption = TOOL_MIN_CONSUMPTION;
 		}
 
@@ -493,6 +498,7 @@ float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource,
 	{
 		if (PeopleData.TechConsumption < TECH_MIN_CONSUMPTION)
 		{
+			Parent->MarkSaveDirty();
 			PeopleData.TechConsumption = TECH_MIN_CONSUMPTION;
 		}
 
@@ -521,6 +527,8 @@ void UFlarePeople::GiveBirth(uint32 BirthCount)
 
 	//FLOGV("Give birth %u people for sector %s", BirthCount, *Parent->GetSectorName().ToString());
 
+	Parent->MarkSaveDirty();
+
 	// Increase population
 	PeopleData.Population += BirthCount;
 
@@ -568,6 +576,7 @@ void UFlarePeople::KillPeople(uint32 KillCount)
 
 	//FLOGV("Kill %u people for sector %s", KillCount, *Parent->GetSectorName().ToString());
 
+	Parent->MarkSaveDirty();
 
 	float KillRatio = (float) PeopleToKill / (float)PeopleData.Population;
 	// Decrease population
@@ -608,9 +617,12 @@ void UFlarePeople::Migrate(UFlareSimulatedSector* DestinationSector, int32 ShipC
 
 		int32 MigratingHappiness = MigratingPopulation * GetHappiness();
 
+		Parent->MarkSaveDirty();
 		PeopleData.HappinessPoint -= MigratingHappiness;
 		PeopleData.Population -= MigratingPopulation;
 
+		DestinationSector->MarkSaveDirty();
+
 		DestinationPeople->GetData()->Population += MigratingPopulation;
 		DestinationPeople->GetData()->HappinessPoint += MigratingHappiness;
 	}
@@ -632,6 +644,7 @@ void UFlarePeople::IncreaseHappiness(float HappinessPoints)
 
 	float Happiness = GetHappiness();
 	float Gain = FMath::Square(Happiness - 2);
+	Parent->MarkSaveDirty();
 	PeopleData.HappinessPoint += HappinessPoints * Gain;
 	PeopleData.HappinessPoint = FMath::Min(PeopleData.HappinessPoint, PeopleData.Population * 200);
 }
@@ -641,12 +654,14 @@ void UFlarePeople::DecreaseHappiness(uint32 SadnessPoints)
 	// Same as for increase but gain are inverted
 	float Happiness = GetHappiness();
 	float Gain = FMath::Square(Happiness);
+	Parent->MarkSaveDirty();
 	PeopleData.HappinessPoint -= SadnessPoints * Gain;
 	PeopleData.HappinessPoint = FMath::Max(PeopleData.HappinessPoint, (uint32) 0);
 }
 
 void UFlarePeople::SetHappiness(float Happiness)
 {
+	Parent->MarkSaveDirty();
 	PeopleData.HappinessPoint = PeopleData.Population * 100 * Happiness;
 }
 
@@ -654,6 +669,8 @@ void UFlarePeople::Pay(uint32 Amount)
 {
 	//FLOGV("Pay to people for sector %s Amount=%f", *Parent->GetSectorName().ToString(), Amount/100.)
 
+	Parent->MarkSaveDirty();
+
 	uint32 Repayment = 0;
 	if(PeopleData.Dept > 0)
 	{
@@ -665,6 +682,8 @@ void UFlarePeople::Pay(uint32 Amount)
 
 void UFlarePeople::TakeMoney(uint32 Amount)
 {
+	Parent->MarkSaveDirty();
+
 	uint32 TakenMoney = FMath::Min(PeopleData.Money, Amount);
 	PeopleData.Money -=  TakenMoney;
 
@@ -673,6 +692,8 @@ void UFlarePeople::TakeMoney(uint32 Amount)
 
 void UFlarePeople::ResetPeople()
 {
+	Parent->MarkSaveDirty();
+
 	PeopleData.Population = 0;
 	PeopleData.BirthPoint = 0;
 	PeopleData.DeathPoint = 0;
@@ -8,6 +8,7 @@
 #include "../FlareCompany.h"
 #include "../FlareSectorHelper.h"
 #include "../FlareScenarioTools.h"
+#include "../FlareSimulationProfiler.h"
 
 #include "../../Data/FlareResourceCatalog.h"
 #include "../../Data/FlareFactoryCatalogEntry.h"
@@ -55,6 +56,7 @@ DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI CargosEvasion"), STAT_FlareCompanyAI_Car
 DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI RepairAndRefill"), STAT_FlareCompanyAI_RepairAndRefill, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI ProcessBudget"), STAT_FlareCompanyAI_ProcessBudget, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI UpdateMilitaryMovement"), STAT_FlareCompanyAI_UpdateMilitaryMovement, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI UpdateWarShipAcquisition"), STAT_FlareCompanyAI_UpdateWarShipAcquisition, STATGROUP_Flare);
 
 
 /*----------------------------------------------------
@@ -68,6 +70,9 @@ UFlareCompanyAI::UFlareCompanyAI(const FObjectInitializer& ObjectInitializer)
 	AllBudgets.Add(EFlareBudget::Station);
 	AllBudgets.Add(EFlareBudget::Technology);
 	AllBudgets.Add(EFlareBudget::Trade);
+
+	EconomySnapshot = NULL;
+	PlanningDate = -1;
 }
 
 void UFlareCompanyAI::Load(UFlareCompany* ParentCompany, const FFlareCompanyAISave& Data)
@@ -101,20 +106,18 @@ void UFlareCompanyAI::Simulate()
 		CheckBattleResolution();
 		UpdateDiplomacy();
 
-		WorldStats = WorldHelper::ComputeWorldResourceStats(Game);
-		Shipyards = FindShipyards();
-
-		// Compute input and output ressource equation (ex: 100 + 10/ day)
-		WorldResourceVariation.Empty();
-		for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+		// The planning pass normally ran for all companies before the first one played,
+		// the plan is dropped when a war state it depends on changed since
+		if (PlanningDate != Game->GetGameWorld()->GetDate())
 		{
-			UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
-			SectorVariation Variation = ComputeSectorResourceVariation(Sector);
-
-			WorldResourceVariation.Add(Sector, Variation);
-			//DumpSectorResourceVariation(Sector, &Variation);
+			Plan();
 		}
 
+		// Trades and travels started today by the companies that played before count too
+		UpdateChangedSectors();
+		ApplyIncomingTravels();
+		Shipyards = FindShipyards();
+
 		Behavior->Simulate();
 
 		PurchaseResearch();
@@ -149,6 +152,34 @@ void UFlareCompanyAI::Simulate()
 	}
 }
 
+void UFlareCompanyAI::Plan()
+{
+	if (Game && Company != Game->GetPC()->GetCompany())
+	{
+		Behavior->Load(Company);
+
+		EconomySnapshot = Game->GetGameWorld()->GetEconomySnapshot();
+		PlanningDate = Game->GetGameWorld()->GetDate();
+
+		// Compute input and output ressource equation (ex: 100 + 10/ day)
+		WorldResourceVariation.Empty();
+		WorldResourceVariation.SetNum(Game->GetGameWorld()->GetSectors().Num());
+		PlannedSectorVersions.Init(0, Game->GetGameWorld()->GetSectors().Num());
+		for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+		{
+			UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+			WorldResourceVariation[Sector->GetWorldIndex()] = ComputeSectorResourceVariation(Sector);
+			PlannedSectorVersions[Sector->GetWorldIndex()] = Game->GetGameWorld()->GetResourceStatsCache().GetSectorVersion(Sector);
+			//DumpSectorResourceVariation(Sector, &WorldResourceVariation[Sector->GetWorldIndex()].ResourceVariations);
+		}
+	}
+}
+
+void UFlareCompanyAI::InvalidatePlan()
+{
+	PlanningDate = -1;
+}
+
 void UFlareCompanyAI::PurchaseResearch()
 {
 	FText Reason;
@@ -207,6 +238,7 @@ void UFlareCompanyAI::UpdateDiplomacy()
 void UFlareCompanyAI::UpdateTrading()
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareCompanyAI_UpdateTrading);
+	FFlareScopedAIStepProfile StepProfile(Company, EFlareAIStep::UpdateTrading);
 
 	IdleCargoCapacity = 0;
 	TArray<UFlareSimulatedSpacecraft*> IdleCargos = FindIdleCargos();
@@ -311,14 +343,14 @@ void UFlareCompanyAI::UpdateTrading()
 					break;
 				}
 
-				SectorVariation* SectorVariationA = &WorldResourceVariation[SectorA];
+				SectorVariation* SectorVariationA = &WorldResourceVariation[SectorA->GetWorldIndex()];
 				if (Ship->GetCurrentSector() != SectorA && SectorVariationA->IncomingCapacity > 0 && SectorBestDeal.BuyQuantity > 0)
 				{
 					//FLOGV("UFlareCompanyAI::UpdateTrading : IncomingCapacity to %s = %d", *SectorA->GetSectorName().ToString(), SectorVariationA->IncomingCapacity);
 					int32 UsedIncomingCapacity = FMath::Min(SectorBestDeal.BuyQuantity, SectorVariationA->IncomingCapacity);
 
 					SectorVariationA->IncomingCapacity -= UsedIncomingCapacity;
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource->Index];
 					VariationA->OwnedStock -= UsedIncomingCapacity;
 				}
 				else
@@ -398,24 +430,24 @@ void UFlareCompanyAI::UpdateTrading()
 					if (BroughtResource > 0)
 					{
 						// Virtualy decrease the stock for other ships in sector A
-						SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA];
-						struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource];
+						SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA->GetWorldIndex()];
+						struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource->Index];
 						VariationA->OwnedStock -= BroughtResource;
 
 
 						// Virtualy say some capacity arrive in sector B
-						SectorVariation* SectorVariationB = &WorldResourceVariation[BestDeal.SectorB];
+						SectorVariation* SectorVariationB = &WorldResourceVariation[BestDeal.SectorB->GetWorldIndex()];
 						SectorVariationB->IncomingCapacity += BroughtResource;
 
 						// Virtualy decrease the capacity for other ships in sector B
-						struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[BestDeal.Resource];
+						struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[BestDeal.Resource->Index];
 						VariationB->OwnedCapacity -= BroughtResource;
 					}
 					else if (BroughtResource == 0)
 					{
 						// Failed to buy the promised resources, remove the deal from the list
-						SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA];
-						struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource];
+						SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA->GetWorldIndex()];
+						struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource->Index];
 						VariationA->FactoryStock = 0;
 						VariationA->OwnedStock = 0;
 						VariationA->StorageStock = 0;
@@ -455,15 +487,15 @@ void UFlareCompanyAI::UpdateTrading()
 				}
 
 				// Reserve the deal by virtualy decrease the stock for other ships
-				SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA];
-				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource];
+				SectorVariation* SectorVariationA = &WorldResourceVariation[BestDeal.SectorA->GetWorldIndex()];
+				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[BestDeal.Resource->Index];
 				VariationA->OwnedStock -= BestDeal.BuyQuantity;
 				// Virtualy say some capacity arrive in sector B
-				SectorVariation* SectorVariationB = &WorldResourceVariation[BestDeal.SectorB];
+				SectorVariation* SectorVariationB = &WorldResourceVariation[BestDeal.SectorB->GetWorldIndex()];
 				SectorVariationB->IncomingCapacity += BestDeal.BuyQuantity;
 
 				// Virtualy decrease the capacity for other ships in sector B
-				struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[BestDeal.Resource];
+				struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[BestDeal.Resource->Index];
 				VariationB->OwnedCapacity -= BestDeal.BuyQuantity;
 			}
 
@@ -647,6 +679,7 @@ void UFlareCompanyAI::ModifyBudget(EFlareBudget::Type Type, int64 Amount)
 void UFlareCompanyAI::ProcessBudget(TArray<EFlareBudget::Type> BudgetToProcess)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareCompanyAI_ProcessBudget);
+	FFlareScopedAIStepProfile StepProfile(Company, EFlareAIStep::ProcessBudget);
 
 	// Find
 #ifdef DEBUG_AI_BUDGET
@@ -981,6 +1014,9 @@ int64 UFlareCompanyAI::UpdateCargoShipAcquisition()
 
 int64 UFlareCompanyAI::UpdateWarShipAcquisition(bool limitToOne)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FlareCompanyAI_UpdateWarShipAcquisition);
+	FFlareScopedAIStepProfile StepProfile(Company, EFlareAIStep::UpdateWarShipAcquisition);
+
 	// For the war pass there is 2 states : slow preventive ship buy. And war state.
 	//
 	// - In the first state, the company will limit his army to a percentage of his value.
@@ -1009,6 +1045,7 @@ int64 UFlareCompanyAI::UpdateWarShipAcquisition(bool limitToOne)
 void UFlareCompanyAI::UpdateMilitaryMovement()
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareCompanyAI_UpdateMilitaryMovement);
+	FFlareScopedAIStepProfile StepProfile(Company, EFlareAIStep::UpdateMilitaryMovement);
 
 	if (Company->AtWar())
 	{
@@ -3166,14 +3203,14 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 	{
 		Score *= Behavior->ConsumerAffility;
 
-		const SectorVariation* ThisSectorVariation = &WorldResourceVariation[Sector];
+		const SectorVariation* ThisSectorVariation = &WorldResourceVariation[Sector->GetWorldIndex()];
 
 		float MaxScoreModifier = 0;
 
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->Index];
 
 
 			float Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -3205,17 +3242,17 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 	{
 		Score *= Behavior->MaintenanceAffility;
 
-		const SectorVariation* ThisSectorVariation = &WorldResourceVariation[Sector];
+		const SectorVariation* ThisSectorVariation = &WorldResourceVariation[Sector->GetWorldIndex()];
 
 		float MaxScoreModifier = 0;
 
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->Index];
 
 
-			int32 Consumption = WorldStats[Resource].Consumption / Company->GetKnownSectors().Num();
+			int32 Consumption = EconomySnapshot->WorldStats[Resource->Index].Consumption / Company->GetKnownSectors().Num();
 			//FLOGV("%s comsumption = %d", *Resource->Name.ToString(), Consumption);
 
 			float ReserveStock =  Variation->MaintenanceMaxStock;
@@ -3251,10 +3288,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Production, EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3289,10 +3326,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Production, EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3329,10 +3366,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 			GainPerCycle -= Sector->GetResourcePrice(&Resource->Resource->Data, EFlareResourcePriceContext::FactoryInput) * Resource->Quantity;
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Production, EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3372,10 +3409,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 
 			//FLOGV(" ResourceAffility for %s: %f", *Resource->Resource->Data.Identifier.ToString(), ResourceAffility);
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Production, EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float OverflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float OverflowRatio = EconomySnapshot->WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (OverflowRatio > 0)
 				{
 					float OverflowMalus = FMath::Clamp(1.f - ((OverflowRatio - 0.1f) * 100)  / ResourceAffility, 0.f, 1.f);
@@ -3463,12 +3500,82 @@ float UFlareCompanyAI::ComputeStationPrice(UFlareSimulatedSector* Sector, FFlare
 }
 
 
+void UFlareCompanyAI::UpdateChangedSectors()
+{
+	FFlareResourceStatsCache& StatsCache = Game->GetGameWorld()->GetResourceStatsCache();
+
+	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+		int32 WorldIndex = Sector->GetWorldIndex();
+		int32 SectorVersion = StatsCache.GetSectorVersion(Sector);
+
+		// Sectors discovered since the plan are computed too
+		if (PlannedSectorVersions[WorldIndex] != SectorVersion
+		 || WorldResourceVariation[WorldIndex].ResourceVariations.Num() == 0)
+		{
+			WorldResourceVariation[WorldIndex] = ComputeSectorResourceVariation(Sector);
+			PlannedSectorVersions[WorldIndex] = SectorVersion;
+		}
+	}
+}
+
+void UFlareCompanyAI::ApplyIncomingTravels()
+{
+	for (int32 TravelIndex = 0; TravelIndex < Game->GetGameWorld()->GetTravels().Num(); TravelIndex++)
+	{
+		UFlareTravel* Travel = Game->GetGameWorld()->GetTravels()[TravelIndex];
+		int32 DestinationIndex = Travel->GetDestinationSector()->GetWorldIndex();
+
+		// Only known sectors have resource flows
+		if (!WorldResourceVariation.IsValidIndex(DestinationIndex) || WorldResourceVariation[DestinationIndex].ResourceVariations.Num() == 0)
+		{
+			continue;
+		}
+
+		SectorVariation& SectorVariation = WorldResourceVariation[DestinationIndex];
+		int64 RemainingTravelDuration = FMath::Max((int64) 1, Travel->GetRemainingTravelDuration());
+
+		UFlareFleet* IncomingFleet = Travel->GetFleet();
+
+		for (int32 ShipIndex = 0; ShipIndex < IncomingFleet->GetShips().Num(); ShipIndex++)
+		{
+			UFlareSimulatedSpacecraft* Ship = IncomingFleet->GetShips()[ShipIndex];
+
+			if (Ship->GetCargoBay()->GetSlotCapacity() == 0 && Ship->GetDamageSystem()->IsStranded())
+			{
+				continue;
+			}
+
+			if (Ship->GetCompany()->GetMoney() > 0)
+			{
+				SectorVariation.IncomingCapacity += Ship->GetCargoBay()->GetCapacity() / RemainingTravelDuration;
+			}
+
+			TArray<FFlareCargo>& CargoBaySlots = Ship->GetCargoBay()->GetSlots();
+			for (int32 CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
+			{
+				FFlareCargo& Cargo = CargoBaySlots[CargoIndex];
+
+				if (!Cargo.Resource)
+				{
+					continue;
+				}
+
+				SectorVariation.ResourceVariations[Cargo.Resource->Index].IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
+			}
+		}
+	}
+}
+
 SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedSector* Sector) const
 {
+	const FFlareSectorEconomySnapshot& SectorSnapshot = EconomySnapshot->SectorSnapshots[Sector->GetWorldIndex()];
+
 	SectorVariation SectorVariation;
+	SectorVariation.ResourceVariations.Reserve(Game->GetResourceCatalog()->Resources.Num());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
 		struct ResourceVariation ResourceVariation;
 		ResourceVariation.OwnedFlow = 0;
 		ResourceVariation.FactoryFlow = 0;
@@ -3485,7 +3592,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 		ResourceVariation.MaintenanceMaxStock = 0;
 		ResourceVariation.HighPriority = 0;
 
-		SectorVariation.ResourceVariations.Add(Resource, ResourceVariation);
+		SectorVariation.ResourceVariations.Add(ResourceVariation);
 	}
 
 	int32 OwnedCustomerStation = 0;
@@ -3516,7 +3623,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -3586,7 +3693,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -3655,7 +3762,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int32 ResourceQuantity = Station->GetCargoBay()->GetResourceQuantity(Resource, Company);
 				int32 CanBuyQuantity =  (int32) (Station->GetCompany()->GetMoney() / Sector->GetResourcePrice(Resource, EFlareResourcePriceContext::FactoryInput));
@@ -3694,7 +3801,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int32 ResourceQuantity = Station->GetCargoBay()->GetResourceQuantity(Resource, Company);
 
@@ -3747,67 +3854,23 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
-
-			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+			int32 Consumption = SectorSnapshot.PeopleConsumption[Resource->Index];
 
 			Variation->OwnedFlow = OwnedCustomerRatio * Consumption;
 			Variation->FactoryFlow = NotOwnedCustomerRatio * Consumption * Behavior->TradingSell;
 		}
 	}
 
-	// Compute incoming capacity and resources
+	// Incoming capacity and resources are added by ApplyIncomingTravels
 	SectorVariation.IncomingCapacity = 0;
-	for (int32 TravelIndex = 0; TravelIndex < Game->GetGameWorld()->GetTravels().Num(); TravelIndex++)
-	{
-		UFlareTravel* Travel = Game->GetGameWorld()->GetTravels()[TravelIndex];
-		if (Travel->GetDestinationSector() != Sector)
-		{
-			continue;
-		}
-
-		int64 RemainingTravelDuration = FMath::Max((int64) 1, Travel->GetRemainingTravelDuration());
-
-		UFlareFleet* IncomingFleet = Travel->GetFleet();
-
-
-		for (int32 ShipIndex = 0; ShipIndex < IncomingFleet->GetShips().Num(); ShipIndex++)
-		{
-			UFlareSimulatedSpacecraft* Ship = IncomingFleet->GetShips()[ShipIndex];
-
-			if (Ship->GetCargoBay()->GetSlotCapacity() == 0 && Ship->GetDamageSystem()->IsStranded())
-			{
-				continue;
-			}
-
-			if( Ship->GetCompany()->GetMoney() > 0)
-			{
-				SectorVariation.IncomingCapacity += Ship->GetCargoBay()->GetCapacity() / RemainingTravelDuration;
-			}
-
-
-			TArray<FFlareCargo>& CargoBaySlots = Ship->GetCargoBay()->GetSlots();
-			for (int32 CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
-			{
-				FFlareCargo& Cargo = CargoBaySlots[CargoIndex];
-
-				if (!Cargo.Resource)
-				{
-					continue;
-				}
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource];
-
-				Variation->IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
-			}
-		}
-	}
 
 	// Add damage fleet and repair to maintenance capacity
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 		for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 		{
@@ -3818,16 +3881,7 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 				continue;
 			}
 
-			int32 NeededFS;
-			int32 TotalNeededFS;
-			int64 MaxDuration;
-			int32 NeededFSSum = 0;
-
-			SectorHelper::GetRefillFleetSupplyNeeds(Sector, OtherCompany, NeededFS, TotalNeededFS, MaxDuration);
-			NeededFSSum += TotalNeededFS;
-
-			SectorHelper::GetRepairFleetSupplyNeeds(Sector, OtherCompany, NeededFS, TotalNeededFS, MaxDuration);
-			NeededFSSum += TotalNeededFS;
+			int32 NeededFSSum = SectorSnapshot.FleetSupplyNeeds[OtherCompany];
 
 			if(OtherCompany == Company)
 			{
@@ -3846,13 +3900,13 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 	return SectorVariation;
 }
 
-void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* SectorVariation) const
+void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* SectorVariation) const
 {
 	FLOGV("DumpSectorResourceVariation : sector %s resource variation: ", *Sector->GetSectorName().ToString());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &(*SectorVariation)[Resource];
+		struct ResourceVariation* Variation = &(*SectorVariation)[ResourceIndex];
 		if (Variation->OwnedFlow ||
 				Variation->FactoryFlow ||
 				Variation->OwnedStock ||
@@ -3953,14 +4007,14 @@ SectorDeal UFlareCompanyAI::FindBestDealForShipFromSector(UFlareSimulatedSpacecr
 		}
 #endif
 
-		SectorVariation* SectorVariationA = &(WorldResourceVariation[SectorA]);
-		SectorVariation* SectorVariationB = &(WorldResourceVariation[SectorB]);
+		SectorVariation* SectorVariationA = &(WorldResourceVariation[SectorA->GetWorldIndex()]);
+		SectorVariation* SectorVariationB = &(WorldResourceVariation[SectorB->GetWorldIndex()]);
 
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Resource];
-			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Resource];
+			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[ResourceIndex];
+			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[ResourceIndex];
 
 #ifdef DEBUG_AI_TRADING
 		if (Company->GetShortName() == DEBUG_AI_TRADING_COMPANY
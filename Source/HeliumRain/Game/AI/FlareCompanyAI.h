@@ -46,7 +46,9 @@ struct ResourceVariation
 struct SectorVariation
 {
 	int32 IncomingCapacity;
-	TMap<FFlareResourceDescription*, ResourceVariation> ResourceVariations;
+
+	/** Resource flows, indexed by resource */
+	TArray<ResourceVariation> ResourceVariations;
 };
 
 struct FFlareDiplomacyStats
@@ -115,6 +117,12 @@ public:
 	/** Simulate a day */
 	virtual void Simulate();
 
+	/** Compute the day plan from the world state. Doesn't modify the world, can run in parallel with other companies */
+	virtual void Plan();
+
+	/** Drop the day plan, so that it's computed again before the company plays */
+	void InvalidatePlan();
+
 	/** Try to purchase research */
 	virtual void PurchaseResearch();
 
@@ -260,8 +268,14 @@ protected:
 	/** Get the resource flow in this sector */
 	SectorVariation ComputeSectorResourceVariation(UFlareSimulatedSector* Sector) const;
 
+	/** Compute the resource flows again for the known sectors changed since the plan */
+	void UpdateChangedSectors();
+
+	/** Add the capacity and resources currently traveling to the known sectors to the resource flows */
+	void ApplyIncomingTravels();
+
 	/** Print the resource flow */
-	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* Variation) const;
+	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* Variation) const;
 
 	SectorDeal FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat);
 
@@ -279,9 +293,11 @@ protected:
 	UFlareAIBehavior*                      Behavior;
 	
 	// Cache
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	const FFlareEconomySnapshot*             EconomySnapshot;
+	int64                                    PlanningDate;
 	TArray<UFlareSimulatedSpacecraft*>       Shipyards;
-	TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
+	TArray<SectorVariation>                  WorldResourceVariation;
+	TArray<int32>                            PlannedSectorVersions;
 
 	TArray<UFlareSimulatedSector*>            SectorWithBattle;
 
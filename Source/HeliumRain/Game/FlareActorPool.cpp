@@ -0,0 +1,264 @@
+
+#include "FlareActorPool.h"
+#include "../Flare.h"
+#include "FlareGame.h"
+#include "../Spacecrafts/FlareBomb.h"
+#include "../Spacecrafts/FlareShell.h"
+#include "../Spacecrafts/FlareSpacecraft.h"
+#include "../Spacecrafts/FlareSimulatedSpacecraft.h"
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Shell hits"), STAT_FlareActorPool_ShellHits, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Shell misses"), STAT_FlareActorPool_ShellMisses, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Bomb hits"), STAT_FlareActorPool_BombHits, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Bomb misses"), STAT_FlareActorPool_BombMisses, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Spacecraft hits"), STAT_FlareActorPool_SpacecraftHits, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Spacecraft misses"), STAT_FlareActorPool_SpacecraftMisses, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Idle shells"), STAT_FlareActorPool_IdleShells, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Idle bombs"), STAT_FlareActorPool_IdleBombs, STATGROUP_Flare);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FlareActorPool Idle spacecrafts"), STAT_FlareActorPool_IdleSpacecrafts, STATGROUP_Flare);
+
+// Idle spacecrafts kept for each spacecraft description, the others are destroyed
+#define POOLED_SPACECRAFTS_PER_DESCRIPTION 8
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+UFlareActorPool::UFlareActorPool(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PooledSpacecraftCount = 0;
+	HitCount = 0;
+	MissCount = 0;
+}
+
+
+/*----------------------------------------------------
+	Public interface
+----------------------------------------------------*/
+
+AFlareShell* UFlareActorPool::AcquireShell(FVector Location, FRotator Rotation, const FActorSpawnParameters& Params)
+{
+	if (PooledShells.Num())
+	{
+		AFlareShell* Shell = PooledShells.Pop(false);
+		UnparkActor(Shell, Location, Rotation, Params);
+
+		HitCount++;
+		INC_DWORD_STAT(STAT_FlareActorPool_ShellHits);
+		UpdateStats();
+		return Shell;
+	}
+
+	MissCount++;
+	INC_DWORD_STAT(STAT_FlareActorPool_ShellMisses);
+	return GetWorld()->SpawnActor<AFlareShell>(AFlareShell::StaticClass(), Location, Rotation, Params);
+}
+
+void UFlareActorPool::ReleaseShell(AFlareShell* Shell)
+{
+	if (ParkActor(Shell))
+	{
+		PooledShells.Add(Shell);
+		UpdateStats();
+	}
+}
+
+AFlareBomb* UFlareActorPool::AcquireBomb(FVector Location, FRotator Rotation, const FActorSpawnParameters& Params)
+{
+	if (PooledBombs.Num())
+	{
+		AFlareBomb* Bomb = PooledBombs.Pop(false);
+		UnparkActor(Bomb, Location, Rotation, Params);
+
+		// Bombs are spawned simulating, before being attached to their weapon
+		Cast<UPrimitiveComponent>(Bomb->GetRootComponent())->SetSimulatePhysics(true);
+
+		HitCount++;
+		INC_DWORD_STAT(STAT_FlareActorPool_BombHits);
+		UpdateStats();
+		return Bomb;
+	}
+
+	MissCount++;
+	INC_DWORD_STAT(STAT_FlareActorPool_BombMisses);
+	return GetWorld()->SpawnActor<AFlareBomb>(AFlareBomb::StaticClass(), Location, Rotation, Params);
+}
+
+void UFlareActorPool::ReleaseBomb(AFlareBomb* Bomb)
+{
+	if (ParkActor(Bomb))
+	{
+		PooledBombs.Add(Bomb);
+		UpdateStats();
+	}
+}
+
+AFlareSpacecraft* UFlareActorPool::AcquireSpacecraft(UFlareSimulatedSpacecraft* ParentSpacecraft, FVector Location, FRotator Rotation, const FActorSpawnParameters& Params)
+{
+	FFlareSpacecraftDescription* Description = ParentSpacecraft->GetDescription();
+	FFlareSpacecraftPool* Pool = PooledSpacecrafts.Find(Description->Identifier);
+
+	if (Pool && Pool->Spacecrafts.Num())
+	{
+		AFlareSpacecraft* Spacecraft = Pool->Spacecrafts.Pop(false);
+		PooledSpacecraftCount--;
+		UnparkActor(Spacecraft, Location, Rotation, Params);
+
+		HitCount++;
+		INC_DWORD_STAT(STAT_FlareActorPool_SpacecraftHits);
+		UpdateStats();
+		return Spacecraft;
+	}
+
+	MissCount++;
+	INC_DWORD_STAT(STAT_FlareActorPool_SpacecraftMisses);
+	return GetWorld()->SpawnActor<AFlareSpacecraft>(Description->SpacecraftTemplate, Location, Rotation, Params);
+}
+
+void UFlareActorPool::ReleaseSpacecraft(AFlareSpacecraft* Spacecraft)
+{
+	if (IsParked(Spacecraft))
+	{
+		return;
+	}
+
+	// Spacecrafts that were never loaded can't be matched to a description
+	if (!Spacecraft->GetParent())
+	{
+		Spacecraft->Destroy();
+		return;
+	}
+
+	// Keep a bounded number of actors for each description
+	FFlareSpacecraftPool& Pool = PooledSpacecrafts.FindOrAdd(Spacecraft->GetDescription()->Identifier);
+	if (Pool.Spacecrafts.Num() >= POOLED_SPACECRAFTS_PER_DESCRIPTION)
+	{
+		Spacecraft->Destroy();
+		return;
+	}
+
+	Spacecraft->Unload();
+	ParkActor(Spacecraft);
+
+	Pool.Spacecrafts.Add(Spacecraft);
+	PooledSpacecraftCount++;
+	UpdateStats();
+}
+
+void UFlareActorPool::Empty()
+{
+	FLOGV("UFlareActorPool::Empty : destroying %d shells, %d bombs, %d spacecrafts (%d hits, %d misses)",
+		PooledShells.Num(), PooledBombs.Num(), PooledSpacecraftCount, HitCount, MissCount);
+
+	// Spacecrafts first, they may own bombs
+	for (auto& Pool : PooledSpacecrafts)
+	{
+		for (AFlareSpacecraft* Spacecraft : Pool.Value.Spacecrafts)
+		{
+			Spacecraft->Destroy();
+		}
+	}
+
+	for (AFlareBomb* Bomb : PooledBombs)
+	{
+		Bomb->Destroy();
+	}
+
+	for (AFlareShell* Shell : PooledShells)
+	{
+		Shell->Destroy();
+	}
+
+	PooledShells.Empty();
+	PooledBombs.Empty();
+	PooledSpacecrafts.Empty();
+	ParkedTickingComponents.Empty();
+	PooledSpacecraftCount = 0;
+	UpdateStats();
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+bool UFlareActorPool::ParkActor(AActor* Actor)
+{
+	if (IsParked(Actor))
+	{
+		return false;
+	}
+
+	FDetachmentTransformRules DetachRules(EDetachmentRule::KeepWorld, true);
+	Actor->DetachFromActor(DetachRules);
+
+	UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+	if (RootComponent)
+	{
+		RootComponent->SetSimulatePhysics(false);
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	// Stop component ticks, remembering which ones to restart
+	TArray<UActorComponent*>& TickingComponents = ParkedTickingComponents.Add(Actor);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component->IsComponentTickEnabled())
+		{
+			Component->SetComponentTickEnabled(false);
+			TickingComponents.Add(Component);
+		}
+	}
+
+	// Attached actors, like shipyard construction states, are hidden with their parent
+	TArray<AActor*> AttachedActors;
+	Actor->GetAttachedActors(AttachedActors);
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		AttachedActor->SetActorHiddenInGame(true);
+	}
+
+	return true;
+}
+
+void UFlareActorPool::UnparkActor(AActor* Actor, FVector Location, FRotator Rotation, const FActorSpawnParameters& Params)
+{
+	Actor->SetActorLocationAndRotation(Location, Rotation, false, NULL, ETeleportType::TeleportPhysics);
+	Actor->SetOwner(Params.Owner);
+	Actor->Instigator = Params.Instigator;
+	Actor->CustomTimeDilation = 1.0;
+
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(true);
+	Actor->SetActorTickEnabled(true);
+
+	TArray<UActorComponent*>* TickingComponents = ParkedTickingComponents.Find(Actor);
+	if (TickingComponents)
+	{
+		for (UActorComponent* Component : *TickingComponents)
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+	ParkedTickingComponents.Remove(Actor);
+
+	TArray<AActor*> AttachedActors;
+	Actor->GetAttachedActors(AttachedActors);
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		AttachedActor->SetActorHiddenInGame(false);
+	}
+}
+
+void UFlareActorPool::UpdateStats()
+{
+	SET_DWORD_STAT(STAT_FlareActorPool_IdleShells, PooledShells.Num());
+	SET_DWORD_STAT(STAT_FlareActorPool_IdleBombs, PooledBombs.Num());
+	SET_DWORD_STAT(STAT_FlareActorPool_IdleSpacecrafts, PooledSpacecraftCount);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Object.h"
+#include "FlareActorPool.generated.h"
+
+
+class AFlareShell;
+class AFlareBomb;
+class AFlareSpacecraft;
+class UFlareSimulatedSpacecraft;
+
+
+/** Idle spacecraft actors of a spacecraft description */
+USTRUCT()
+struct FFlareSpacecraftPool
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<AFlareSpacecraft*>                  Spacecrafts;
+};
+
+
+/** Recycles shells, bombs and spacecraft actors instead of spawning and destroying them */
+UCLASS()
+class HELIUMRAIN_API UFlareActorPool : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/*----------------------------------------------------
+		Public interface
+	----------------------------------------------------*/
+
+	/** Get an idle shell, or spawn a new one */
+	AFlareShell* AcquireShell(FVector Location, FRotator Rotation, const FActorSpawnParameters& Params);
+
+	/** Park a shell until the next shot */
+	void ReleaseShell(AFlareShell* Shell);
+
+	/** Get an idle bomb, or spawn a new one */
+	AFlareBomb* AcquireBomb(FVector Location, FRotator Rotation, const FActorSpawnParameters& Params);
+
+	/** Park a bomb until the next refill */
+	void ReleaseBomb(AFlareBomb* Bomb);
+
+	/** Get an idle spacecraft actor of this spacecraft description, or spawn a new one. The actor still needs to be loaded. */
+	AFlareSpacecraft* AcquireSpacecraft(UFlareSimulatedSpacecraft* ParentSpacecraft, FVector Location, FRotator Rotation, const FActorSpawnParameters& Params);
+
+	/** Unload a spacecraft actor and park it until its description is needed again */
+	void ReleaseSpacecraft(AFlareSpacecraft* Spacecraft);
+
+	/** Destroy all idle actors */
+	void Empty();
+
+
+protected:
+
+	/*----------------------------------------------------
+		Internals
+	----------------------------------------------------*/
+
+	/** Hide an actor, stop its physics, collisions and ticks. Return false if the actor was already parked. */
+	bool ParkActor(AActor* Actor);
+
+	/** Bring a parked actor back to life */
+	void UnparkActor(AActor* Actor, FVector Location, FRotator Rotation, const FActorSpawnParameters& Params);
+
+	/** Update the idle actor stats */
+	void UpdateStats();
+
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	UPROPERTY()
+	TArray<AFlareShell*>                       PooledShells;
+
+	UPROPERTY()
+	TArray<AFlareBomb*>                        PooledBombs;
+
+	// Idle spacecrafts by description identifier
+	UPROPERTY()
+	TMap<FName, FFlareSpacecraftPool>          PooledSpacecrafts;
+
+	// Components that were ticking when their actor was parked
+	TMap<AActor*, TArray<UActorComponent*>>    ParkedTickingComponents;
+
+	int32                                      PooledSpacecraftCount;
+	int32                                      HitCount;
+	int32                                      MissCount;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	/** Get the number of actors reused from the pool */
+	inline int32 GetHitCount() const
+	{
+		return HitCount;
+	}
+
+	/** Get the number of actors that had to be spawned */
+	inline int32 GetMissCount() const
+	{
+		return MissCount;
+	}
+
+	inline bool IsParked(AActor* Actor) const
+	{
+		return ParkedTickingComponents.Contains(Actor);
+	}
+
+};
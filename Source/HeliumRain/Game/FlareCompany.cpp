@@ -31,6 +31,9 @@
 
 UFlareCompany::UFlareCompany(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, WorldIndex(INDEX_NONE)
+	, SaveDirty(true)
+	, LastSaveRewriteCount(0)
 {
 }
 
@@ -44,6 +47,7 @@ void UFlareCompany::Load(const FFlareCompanySave& Data)
 	Game = Cast<UFlareWorld>(GetOuter())->GetGame();
 	CompanyData = Data;
 	CompanyData.Identifier = FName(*GetName());
+	SaveDirty = true;
 
 	// Player description ID is -1
 	if (Data.CatalogIdentifier >= 0)
@@ -104,6 +108,10 @@ void UFlareCompany::PostLoad()
 {
 	VisitedSectors.Empty();
 	KnownSectors.Empty();
+	for (UFlareTradeRoute* TradeRoute : CompanyTradeRoutes)
+	{
+		GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
+	}
 	CompanyTradeRoutes.Empty();
 
 	// Load all trade routes
@@ -139,13 +147,52 @@ void UFlareCompany::PostLoad()
 
 }
 
-FFlareCompanySave* UFlareCompany::Save()
+/** Update the save data of a spacecraft list, rewriting only the spacecrafts that changed. Return the number of rewritten spacecrafts */
+static int32 SaveSpacecraftList(const TArray<UFlareSimulatedSpacecraft*>& Spacecrafts, TArray<FFlareSpacecraftSave>& SpacecraftData)
 {
-	CompanyData.Fleets.Empty();
-	CompanyData.TradeRoutes.Empty();
+	bool SameList = (Spacecrafts.Num() == SpacecraftData.Num());
+	for (int i = 0; SameList && i < Spacecrafts.Num(); i++)
+	{
+		SameList = (SpacecraftData[i].Immatriculation == Spacecrafts[i]->GetImmatriculation());
+	}
+
+	// Spacecrafts were added, removed or moved : rewrite the whole list
+	if (!SameList)
+	{
+		SpacecraftData.Reset(Spacecrafts.Num());
+		for (int i = 0; i < Spacecrafts.Num(); i++)
+		{
+			SpacecraftData.Add(*Spacecrafts[i]->Save());
+		}
+		return Spacecrafts.Num();
+	}
+
+	int32 RewriteCount = 0;
+	for (int i = 0; i < Spacecrafts.Num(); i++)
+	{
+		if (Spacecrafts[i]->IsSaveDirty())
+		{
+			SpacecraftData[i] = *Spacecrafts[i]->Save();
+			RewriteCount++;
+		}
+	}
+	return RewriteCount;
+}
+
+void UFlareCompany::Save(FFlareCompanySave& SaveData)
+{
+	// The spacecraft lists are updated in place in the previous save data
+	TArray<FFlareSpacecraftSave> ShipData = MoveTemp(SaveData.ShipData);
+	TArray<FFlareSpacecraftSave> StationData = MoveTemp(SaveData.StationData);
+	TArray<FFlareSpacecraftSave> DestroyedSpacecraftData = MoveTemp(SaveData.DestroyedSpacecraftData);
+
+	// The loaded spacecraft lists are outdated once the spacecrafts exist
 	CompanyData.ShipData.Empty();
 	CompanyData.StationData.Empty();
 	CompanyData.DestroyedSpacecraftData.Empty();
+
+	CompanyData.Fleets.Empty();
+	CompanyData.TradeRoutes.Empty();
 	CompanyData.SectorsKnowledge.Empty();
 	CompanyData.UnlockedTechnologies.Empty();
 
@@ -159,21 +206,6 @@ FFlareCompanySave* UFlareCompany::Save()
 		CompanyData.TradeRoutes.Add(*CompanyTradeRoutes[i]->Save());
 	}
 
-	for (int i = 0 ; i < CompanyShips.Num(); i++)
-	{
-		CompanyData.ShipData.Add(*CompanyShips[i]->Save());
-	}
-
-	for (int i = 0 ; i < CompanyStations.Num(); i++)
-	{
-		CompanyData.StationData.Add(*CompanyStations[i]->Save());
-	}
-
-	for (int i = 0 ; i < CompanyDestroyedSpacecrafts.Num(); i++)
-	{
-		CompanyData.DestroyedSpacecraftData.Add(*CompanyDestroyedSpacecrafts[i]->Save());
-	}
-
 	for (int i = 0 ; i < VisitedSectors.Num(); i++)
 	{
 		FFlareCompanySectorKnowledge SectorKnowledge;
@@ -205,7 +237,35 @@ FFlareCompanySave* UFlareCompany::Save()
 
 	CompanyData.AI = *CompanyAI->Save();
 
-	return &CompanyData;
+	SaveData = CompanyData;
+	SaveData.ShipData = MoveTemp(ShipData);
+	SaveData.StationData = MoveTemp(StationData);
+	SaveData.DestroyedSpacecraftData = MoveTemp(DestroyedSpacecraftData);
+
+	LastSaveRewriteCount = SaveSpacecraftList(CompanyShips, SaveData.ShipData);
+	LastSaveRewriteCount += SaveSpacecraftList(CompanyStations, SaveData.StationData);
+	LastSaveRewriteCount += SaveSpacecraftList(CompanyDestroyedSpacecrafts, SaveData.DestroyedSpacecraftData);
+
+	SaveDirty = false;
+}
+
+bool UFlareCompany::IsSaveDirty() const
+{
+	// Player actions change the player company in many ways, always save it
+	if (SaveDirty || IsPlayerCompany())
+	{
+		return true;
+	}
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : CompanySpacecrafts)
+	{
+		if (Spacecraft->IsSaveDirty())
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
 
@@ -236,6 +296,16 @@ EFlareHostility::Type UFlareCompany::GetPlayerHostility() const
 }
 
 EFlareHostility::Type UFlareCompany::GetHostility(const UFlareCompany* TargetCompany) const
+{
+	if (TargetCompany && WorldIndex != INDEX_NONE && TargetCompany->WorldIndex != INDEX_NONE)
+	{
+		return Game->GetGameWorld()->GetCachedHostility(WorldIndex, TargetCompany->WorldIndex);
+	}
+
+	return ComputeHostility(TargetCompany);
+}
+
+EFlareHostility::Type UFlareCompany::ComputeHostility(const UFlareCompany* TargetCompany) const
 {
 	if (TargetCompany == this)
 	{
@@ -267,6 +337,10 @@ EFlareHostility::Type UFlareCompany::GetWarState(const UFlareCompany* TargetComp
 	{
 		return EFlareHostility::Owned;
 	}
+	else if (WorldIndex != INDEX_NONE && TargetCompany->WorldIndex != INDEX_NONE)
+	{
+		return Game->GetGameWorld()->GetCachedWarState(WorldIndex, TargetCompany->WorldIndex);
+	}
 	else if (GetHostility(TargetCompany) == EFlareHostility::Hostile || TargetCompany->GetHostility(this) == EFlareHostility::Hostile)
 	{
 		return EFlareHostility::Hostile;
@@ -282,21 +356,29 @@ bool UFlareCompany::IsAtWar(const UFlareCompany* TargetCompany) const
 
 void UFlareCompany::ClearLastWarDate()
 {
+	MarkSaveDirty();
+
 	CompanyData.PlayerLastWarDate = 0;
 }
 
 void UFlareCompany::SetLastWarDate()
 {
+	MarkSaveDirty();
+
 	CompanyData.PlayerLastWarDate = Game->GetGameWorld()->GetDate();
 }
 
 void UFlareCompany::ResetLastPeaceDate()
 {
+	MarkSaveDirty();
+
 	CompanyData.PlayerLastPeaceDate = Game->GetGameWorld()->GetDate();
 }
 
 void UFlareCompany::ResetLastTributeDate()
 {
+	MarkSaveDirty();
+
 	CompanyData.PlayerLastTributeDate = Game->GetGameWorld()->GetDate();
 }
 
@@ -307,7 +389,9 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		bool WasHostile = CompanyData.HostileCompanies.Contains(TargetCompany->GetIdentifier());
 		if (Hostile && !WasHostile)
 		{
+			MarkSaveDirty();
 			CompanyData.HostileCompanies.AddUnique(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->UpdateHostility(this, TargetCompany);
 
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
@@ -341,7 +425,9 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		}
 		else if(!Hostile && WasHostile)
 		{
+			MarkSaveDirty();
 			CompanyData.HostileCompanies.Remove(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->UpdateHostility(this, TargetCompany);
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
@@ -415,6 +501,8 @@ FLinearColor UFlareCompany::PickFleetColor() const
 
 UFlareFleet* UFlareCompany::CreateFleet(FText FleetName, UFlareSimulatedSector* FleetSector)
 {
+	MarkSaveDirty();
+
 	// Create the fleet
 	FFlareFleetSave FleetData;
 	FleetData.Identifier = FName(*(GetIdentifier().ToString() + "-" + FString::FromInt(CompanyData.FleetImmatriculationIndex++)));
@@ -427,6 +515,8 @@ UFlareFleet* UFlareCompany::CreateFleet(FText FleetName, UFlareSimulatedSector*
 
 UFlareFleet* UFlareCompany::CreateAutomaticFleet(UFlareSimulatedSpacecraft* Spacecraft)
 {
+	MarkSaveDirty();
+
 	FText FleetName;
 	int32 FleetIndex = 1;
 
@@ -487,6 +577,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 	Fleet = NewObject<UFlareFleet>(this, UFlareFleet::StaticClass());
 	Fleet->Load(FleetData);
 	CompanyFleets.AddUnique(Fleet);
+	GetGame()->GetGameWorld()->RegisterFleet(Fleet);
 
 	//FLOGV("UFlareWorld::LoadFleet : loaded fleet '%s'", *Fleet->GetFleetName().ToString());
 
@@ -495,7 +586,10 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 
 void UFlareCompany::RemoveFleet(UFlareFleet* Fleet)
 {
+	MarkSaveDirty();
+
 	CompanyFleets.Remove(Fleet);
+	GetGame()->GetGameWorld()->UnregisterFleet(Fleet);
 }
 
 void UFlareCompany::MoveFleetUp(UFlareFleet* Fleet)
@@ -504,6 +598,7 @@ void UFlareCompany::MoveFleetUp(UFlareFleet* Fleet)
 
 	if(Index != INDEX_NONE && Index > 0)
 	{
+		MarkSaveDirty();
 		int32 SwapIndex = Index - 1;
 		UFlareFleet* SwapFleet = CompanyFleets[SwapIndex];
 
@@ -518,6 +613,7 @@ void UFlareCompany::MoveFleetDown(UFlareFleet* Fleet)
 
 	if(Index != INDEX_NONE && Index < CompanyFleets.Num() - 1)
 	{
+		MarkSaveDirty();
 		int32 SwapIndex = Index + 1;
 		UFlareFleet* SwapFleet = CompanyFleets[SwapIndex];
 
@@ -528,6 +624,8 @@ void UFlareCompany::MoveFleetDown(UFlareFleet* Fleet)
 
 UFlareTradeRoute* UFlareCompany::CreateTradeRoute(FText TradeRouteName)
 {
+	MarkSaveDirty();
+
 	// Create the trade route
 	FFlareTradeRouteSave TradeRouteData;
 	TradeRouteData.Identifier = FName(*(GetIdentifier().ToString() + "-" + FString::FromInt(CompanyData.TradeRouteImmatriculationIndex++)));
@@ -553,6 +651,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 	TradeRoute = NewObject<UFlareTradeRoute>(this, UFlareTradeRoute::StaticClass());
 	TradeRoute->Load(TradeRouteData);
 	CompanyTradeRoutes.AddUnique(TradeRoute);
+	GetGame()->GetGameWorld()->RegisterTradeRoute(TradeRoute);
 
 	//FLOGV("UFlareCompany::LoadTradeRoute : loaded trade route '%s'", *TradeRoute->GetTradeRouteName().ToString());
 
@@ -561,11 +660,16 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 
 void UFlareCompany::RemoveTradeRoute(UFlareTradeRoute* TradeRoute)
 {
+	MarkSaveDirty();
+
 	CompanyTradeRoutes.Remove(TradeRoute);
+	GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
 }
 
 UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftSave& SpacecraftData)
 {
+	MarkSaveDirty();
+
 	UFlareSimulatedSpacecraft* Spacecraft = NULL;
 	//FLOGV("UFlareCompany::LoadSpacecraft ('%s')", *SpacecraftData.Immatriculation.ToString());
 
@@ -603,6 +707,8 @@ UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftS
 
 			CompanySpacecrafts.AddUnique((Spacecraft));
 		}
+
+		Game->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 	}
 	else
 	{
@@ -614,6 +720,8 @@ UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftS
 
 void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
+	MarkSaveDirty();
+
 	FLOGV("UFlareCompany::DestroySpacecraft : Remove %s from company %s", *Spacecraft->GetImmatriculation().ToString(), *GetCompanyName().ToString());
 
 	Spacecraft->ResetCapture();
@@ -635,17 +743,28 @@ void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 	Spacecraft->SetDestroyed(true);
 
 	CompanyDestroyedSpacecrafts.Add(Spacecraft);
+	GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 }
 
 void UFlareCompany::DiscoverSector(UFlareSimulatedSector* Sector)
 {
-	KnownSectors.AddUnique(Sector);
+	if (!KnownSectors.Contains(Sector))
+	{
+		MarkSaveDirty();
+		KnownSectors.Add(Sector);
+	}
 }
 
 void UFlareCompany::VisitSector(UFlareSimulatedSector* Sector)
 {
 	DiscoverSector(Sector);
-	VisitedSectors.AddUnique(Sector);
+
+	if (!VisitedSectors.Contains(Sector))
+	{
+		MarkSaveDirty();
+		VisitedSectors.Add(Sector);
+	}
+
 	if (GetGame()->GetQuestManager())
 	{
 		GetGame()->GetQuestManager()->OnSectorVisited(Sector);
@@ -662,6 +781,7 @@ bool UFlareCompany::TakeMoney(int64 Amount, bool AllowDepts)
 	}
 	else
 	{
+		MarkSaveDirty();
 		CompanyData.Money -= Amount;
 		/*if (Amount > 0)
 		{
@@ -684,6 +804,7 @@ void UFlareCompany::GiveMoney(int64 Amount)
 		return;
 	}
 
+	MarkSaveDirty();
 	CompanyData.Money += Amount;
 
 	if (this == Game->GetPC()->GetCompany() && GetGame()->GetQuestManager())
@@ -713,6 +834,7 @@ void UFlareCompany::GiveResearch(int64 Amount)
 		Amount *= 1.5;
 	}
 
+	MarkSaveDirty();
 	CompanyData.ResearchAmount += Amount;
 
 
@@ -724,6 +846,8 @@ void UFlareCompany::GiveResearch(int64 Amount)
 
 void UFlareCompany::GivePlayerReputation(float Amount, float Max)
 {
+	MarkSaveDirty();
+
 	if(Max < -100)
 	{
 		CompanyData.PlayerReputation = FMath::Max(-100.f, CompanyData.PlayerReputation + Amount);
@@ -1116,6 +1240,8 @@ void UFlareCompany::PayTribute(UFlareCompany* Company, bool AllowDepts)
 
 void UFlareCompany::GiveShame(float ShameGain)
 {
+	MarkSaveDirty();
+
 	CompanyData.Shame += ShameGain;
 }
 
@@ -1126,13 +1252,16 @@ void UFlareCompany::StartCapture(UFlareSimulatedSpacecraft* Station)
 		return;
 	}
 
+	MarkSaveDirty();
 	CompanyData.CaptureOrders.AddUnique(Station->GetImmatriculation());
 }
 
 void UFlareCompany::StopCapture(UFlareSimulatedSpacecraft* Station)
 {
-
-	CompanyData.CaptureOrders.Remove(Station->GetImmatriculation());
+	if (CompanyData.CaptureOrders.Remove(Station->GetImmatriculation()) > 0)
+	{
+		MarkSaveDirty();
+	}
 }
 
 bool UFlareCompany::CanStartCapture(UFlareSimulatedSpacecraft* Station)
@@ -1408,6 +1537,8 @@ void UFlareCompany::UnlockTechnology(FName Identifier, bool FromSave, bool Force
 
 		if (!FromSave)
 		{
+			MarkSaveDirty();
+
 			int32 Cost = GetTechnologyCost(Technology);
 
 			if (!Force)
@@ -1577,12 +1708,10 @@ UFlareSimulatedSpacecraft* UFlareCompany::FindSpacecraft(FName ShipImmatriculati
 {
 	if(!Destroyed )
 	{
-		for (UFlareSimulatedSpacecraft* Spacecraft : CompanySpacecrafts)
+		UFlareSimulatedSpacecraft* Spacecraft = Game->GetGameWorld()->FindSpacecraft(ShipImmatriculation);
+		if (Spacecraft && !Spacecraft->IsDestroyed() && Spacecraft->GetCompany() == this)
 		{
-			if (Spacecraft->GetImmatriculation() == ShipImmatriculation)
-			{
-				return Spacecraft;
-			}
+			return Spacecraft;
 		}
 	}
 	else
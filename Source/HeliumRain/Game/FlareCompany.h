@@ -35,8 +35,23 @@ public:
 	/** Post Load to perform task needing sectors to be loaded */
 	virtual void PostLoad();
 
-	/** Save the company to a save file */
-	virtual FFlareCompanySave* Save();
+	/** Save the company into its previous save data. Only the spacecrafts that changed since then are rewritten */
+	virtual void Save(FFlareCompanySave& SaveData);
+
+	/** Flag the save data as outdated, so that the next world save rewrites it */
+	inline void MarkSaveDirty()
+	{
+		SaveDirty = true;
+	}
+
+	/** Check if the company or one of its spacecrafts changed since it was last saved */
+	bool IsSaveDirty() const;
+
+	/** Get the number of spacecrafts rewritten by the last save */
+	inline int32 GetLastSaveRewriteCount() const
+	{
+		return LastSaveRewriteCount;
+	}
 
 	/** Spawn a simulated spacecraft from save data */
 	virtual UFlareSimulatedSpacecraft* LoadSpacecraft(const FFlareSpacecraftSave& SpacecraftData);
@@ -63,6 +78,9 @@ public:
 	/** Check if we are friend or foe toward this target company */
 	virtual EFlareHostility::Type GetHostility(const UFlareCompany* TargetCompany) const;
 
+	/** Compute the hostility toward this target company from the save data, without the world diplomacy cache */
+	EFlareHostility::Type ComputeHostility(const UFlareCompany* TargetCompany) const;
+
 	/** Check if we are friend or foe toward this target company. Hostile if at least one company is hostile */
 	virtual EFlareHostility::Type GetPlayerWarState() const;
 
@@ -234,6 +252,9 @@ protected:
 	FSlateBrush                             CompanyEmblemBrush;
 
 	AFlareGame*                             Game;
+	int32                                   WorldIndex;
+	bool                                    SaveDirty;
+	int32                                   LastSaveRewriteCount;
 	TArray<UFlareSimulatedSector*>          KnownSectors;
 	TArray<UFlareSimulatedSector*>          VisitedSectors;
 
@@ -267,6 +288,17 @@ public:
 		return CompanyData.Identifier;
 	}
 
+	/** Get the index of this company in the world company list */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	inline const FFlareCompanyDescription* GetDescription() const
 	{
 		return CompanyDescription;
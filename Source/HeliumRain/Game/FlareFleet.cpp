@@ -6,6 +6,7 @@
 #include "FlareGame.h"
 #include "FlareGameTools.h"
 #include "FlareSimulatedSector.h"
+#include "FlareWorld.h"
 
 #include "../Economy/FlareCargoBay.h"
 
@@ -386,6 +387,7 @@ void UFlareFleet::AddShip(UFlareSimulatedSpacecraft* Ship)
 	FleetData.ShipImmatriculations.Add(Ship->GetImmatriculation());
 	FleetShips.AddUnique(Ship);
 	Ship->SetCurrentFleet(this);
+	GetGame()->GetGameWorld()->InvalidateIncomingEvents();
 
 	if (FleetCompany == GetGame()->GetPC()->GetCompany() && GetGame()->GetQuestManager())
 	{
@@ -404,6 +406,7 @@ void UFlareFleet::RemoveShip(UFlareSimulatedSpacecraft* Ship, bool destroyed)
 	FleetData.ShipImmatriculations.Remove(Ship->GetImmatriculation());
 	FleetShips.Remove(Ship);
 	Ship->SetCurrentFleet(NULL);
+	GetGame()->GetGameWorld()->InvalidateIncomingEvents();
 
 	if (!destroyed)
 	{
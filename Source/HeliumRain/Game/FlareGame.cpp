@@ -6,9 +6,11 @@
 #include "FlareWorld.h"
 #include "FlareAsteroid.h"
 #include "FlareDebrisField.h"
+#include "FlareActorPool.h"
 #include "FlarePlanetarium.h"
 #include "FlareGameTools.h"
 #include "FlareScenarioTools.h"
+#include "FlareSimulationBenchmark.h"
 
 #include "Save/FlareSaveGameSystem.h"
 
@@ -44,6 +46,11 @@
 
 #define LOCTEXT_NAMESPACE "FlareGame"
 
+// Time the game thread may spend on an asynchronous save, in seconds
+#define SAVE_GAME_THREAD_BUDGET 0.016
+
+DECLARE_CYCLE_STAT(TEXT("FlareGame SaveGame"), STAT_FlareGame_SaveGame, STATGROUP_Flare);
+
 
 /*----------------------------------------------------
 	Constructor
@@ -154,6 +161,16 @@ void AFlareGame::StartPlay()
 
 	// Spawn debris field system
 	DebrisFieldSystem = NewObject<UFlareDebrisField>(this, UFlareDebrisField::StaticClass());
+
+	// Actor pool
+	ActorPool = NewObject<UFlareActorPool>(this, UFlareActorPool::StaticClass());
+
+	// Headless benchmark
+	if (UFlareSimulationBenchmark::IsRequested())
+	{
+		SimulationBenchmark = NewObject<UFlareSimulationBenchmark>(this, UFlareSimulationBenchmark::StaticClass());
+		SimulationBenchmark->Init();
+	}
 }
 
 void AFlareGame::PostLogin(APlayerController* Player)
@@ -229,6 +246,7 @@ UFlareSimulatedSector* AFlareGame::DeactivateSector()
 	UFlareSimulatedSector* Sector = ActiveSector->GetSimulatedSector();
 	FLOGV("AFlareGame::DeactivateSector : %s", *Sector->GetSectorName().ToString());
 	World->Save();
+	World->InvalidateIncomingEvents();
 
 	// Set last flown ship
 	UFlareSimulatedSpacecraft* PlayerShip = NULL;
@@ -386,6 +404,26 @@ float AFlareGame::GetAINerfRatio()
 void AFlareGame::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
+
+	// Run the benchmark once the player controller is set up, then quit
+	if (SimulationBenchmark)
+	{
+		AFlarePlayerController* PC = Cast<AFlarePlayerController>(GetWorld()->GetFirstPlayerController());
+		if (PC && PC->GetMenuManager())
+		{
+			bool BenchmarkResult = SimulationBenchmark->Run(PC);
+			SimulationBenchmark = NULL;
+			FLOGV("AFlareGame::Tick : benchmark %s, exiting", BenchmarkResult ? TEXT("done") : TEXT("failed"));
+			FPlatformMisc::RequestExit(false);
+			return;
+		}
+	}
+
+	// Spawn the rest of the sector being activated, quests only see it once complete
+	if (ActiveSector && ActiveSector->IsLoading() && ActiveSector->ContinueLoading())
+	{
+		GetQuestManager()->OnSectorActivation(ActiveSector->GetSimulatedSector());
+	}
 	
 	if (QuestManager)
 	{
@@ -418,56 +456,45 @@ void AFlareGame::ReadAllSaveSlots()
 	{
 		FFlareSaveSlotInfo SaveSlotInfo;
 		SaveSlotInfo.EmblemBrush.ImageSize = EmblemSize;
-		UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
-		SaveSlotInfo.Save = Save;
+		FString SaveFile = "SaveSlot" + FString::FromInt(Index);
 
-		if (Save)
+		// Read the summary, or the full save for older files
+		FFlareSaveMetadata Metadata;
+		SaveSlotInfo.Exists = SaveGameSystem->LoadMetadata(SaveFile, Metadata);
+		if (!SaveSlotInfo.Exists)
 		{
-			SaveSlotInfo.UUID = Save->PlayerData.UUID;
-
-			// Basic setup
-			UFlareCustomizationCatalog* Catalog = GetCustomizationCatalog();
-			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
-
-			// Count player ships
-			SaveSlotInfo.CompanyShipCount = 0;
-
-			// Find player company and count ships
-			FFlareCompanySave* PlayerCompany = NULL;
-            for (int32 CompanyIndex = 0; CompanyIndex < Save->WorldData.CompanyData.Num(); CompanyIndex++)
+			UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
+			if (Save)
 			{
-                const FFlareCompanySave& Company = Save->WorldData.CompanyData[CompanyIndex];
-				if (Company.Identifier == Save->PlayerData.CompanyIdentifier)
-				{
-                    PlayerCompany = &(Save->WorldData.CompanyData[CompanyIndex]);
-					SaveSlotInfo.CompanyShipCount = Save->WorldData.CompanyData[CompanyIndex].ShipData.Num();
-				}
+				FLOGV("AFlareGame::ReadAllSaveSlots : no metadata in slot %d, using full save", Index);
+				Metadata.Init(Save, 0);
+				SaveSlotInfo.Exists = true;
 			}
+		}
 
-			// Company info
-			if (PlayerCompany)
-			{
-				const FFlareCompanyDescription* Desc = &Save->PlayerCompanyDescription;
-
-				// Money and general infos
-				SaveSlotInfo.CompanyValue = PlayerCompany->CompanyValue;
-				SaveSlotInfo.CompanyName = Desc->Name;
-
-				// Emblem material
-				SaveSlotInfo.Emblem = UMaterialInstanceDynamic::Create(BaseEmblemMaterial, GetWorld());
-				SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Save->PlayerData.PlayerEmblemIndex));
-				SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Desc->CustomizationBasePaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Desc->CustomizationPaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Desc->CustomizationOverlayColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Desc->CustomizationLightColor);
-
-				// Create the brush dynamically
-				SaveSlotInfo.EmblemBrush.SetResourceObject(SaveSlotInfo.Emblem);
-			}
+		if (SaveSlotInfo.Exists)
+		{
+			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
+
+			// Money and general infos
+			SaveSlotInfo.UUID = Metadata.UUID;
+			SaveSlotInfo.CompanyShipCount = Metadata.CompanyShipCount;
+			SaveSlotInfo.CompanyValue = Metadata.CompanyValue;
+			SaveSlotInfo.CompanyName = Metadata.CompanyName;
+
+			// Emblem material
+			SaveSlotInfo.Emblem = UMaterialInstanceDynamic::Create(BaseEmblemMaterial, GetWorld());
+			SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Metadata.PlayerEmblemIndex));
+			SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Metadata.BasePaintColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Metadata.PaintColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Metadata.OverlayColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Metadata.LightColor);
+
+			// Create the brush dynamically
+			SaveSlotInfo.EmblemBrush.SetResourceObject(SaveSlotInfo.Emblem);
 		}
 		else
 		{
-			SaveSlotInfo.Save = NULL;
 			SaveSlotInfo.Emblem = NULL;
 			SaveSlotInfo.EmblemBrush = FSlateNoResource();
 			SaveSlotInfo.CompanyShipCount = 0;
@@ -500,7 +527,7 @@ void AFlareGame::SetCurrentSlot(int32 Index)
 bool AFlareGame::DoesSaveSlotExist(int32 Index) const
 {
 	int32 RealIndex = Index - 1;
-	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Save;
+	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Exists;
 }
 
 const FFlareSaveSlotInfo& AFlareGame::GetSaveSlotInfo(int32 Index)
@@ -517,7 +544,7 @@ UFlareSaveGame* AFlareGame::ReadSaveSlot(int32 Index)
 	// Prototype load
 	if (SaveGameSystem->DoesSaveGameExist(SaveFile))
 	{
-		FLOG("AFlareGame::ReadSaveSlot : using JSON");
+		FLOG("AFlareGame::ReadSaveSlot : using save system");
 		Save = SaveGameSystem->LoadGame(SaveFile);
 	}
 	
@@ -540,13 +567,20 @@ bool AFlareGame::DeleteSaveSlot(int32 Index)
 	if (DoesSaveSlotExist(Index))
 	{
 		const FFlareSaveSlotInfo& SaveSlotInfo = GetSaveSlotInfo(Index);
-		FString FileName1 = FString::Printf(TEXT("%s/SaveGames/Combat-%s.log"), *FPaths::GameSavedDir(), *SaveSlotInfo.UUID.ToString());
-		FLOGV("Delete %s", *FileName1);
 
-		IFileManager::Get().Delete(*FileName1, true);
-		FString FileName2 = FString::Printf(TEXT("%s/SaveGames/Game-%s.log"), *FPaths::GameSavedDir(), *SaveSlotInfo.UUID.ToString());
-		FLOGV("Delete %s", *FileName2);
-		IFileManager::Get().Delete(*FileName2, true);
+		// Logs written by FFlareLogWriter, and the plain text logs of older versions
+		const TCHAR* LogExtensions[] = { TEXT("flog"), TEXT("log") };
+		const TCHAR* LogNames[] = { TEXT("Combat"), TEXT("Game") };
+
+		for (const TCHAR* LogExtension : LogExtensions)
+		{
+			for (const TCHAR* LogName : LogNames)
+			{
+				FString FileName = FString::Printf(TEXT("%s/SaveGames/%s-%s.%s"), *FPaths::GameSavedDir(), LogName, *SaveSlotInfo.UUID.ToString(), LogExtension);
+				FLOGV("Delete %s", *FileName);
+				IFileManager::Get().Delete(*FileName, true);
+			}
+		}
 	}
 
 	bool Deleted = false;
@@ -685,7 +719,9 @@ bool AFlareGame::LoadGame(AFlarePlayerController* PC)
 	Clean();
 	PC->Clean();
 
+	double StartTs = FPlatformTime::Seconds();
 	UFlareSaveGame* Save = ReadSaveSlot(CurrentSaveIndex);
+	double ReadTs = FPlatformTime::Seconds();
 
 	// Load from save
 	if (PC && Save)
@@ -696,6 +732,7 @@ bool AFlareGame::LoadGame(AFlarePlayerController* PC)
         World = NewObject<UFlareWorld>(this, UFlareWorld::StaticClass());
 		FLOGV("AFlareGame::LoadGame date=%lld", Save->WorldData.Date);
         World->Load(Save->WorldData);
+		double WorldTs = FPlatformTime::Seconds();
 		CurrentImmatriculationIndex = Save->CurrentImmatriculationIndex;
 		CurrentIdentifierIndex = Save->CurrentIdentifierIndex;
 		AutoSave = Save->AutoSave;
@@ -711,6 +748,7 @@ bool AFlareGame::LoadGame(AFlarePlayerController* PC)
 		ScenarioTools->Init(PC->GetCompany(), &Save->PlayerData);
 		World->PostLoad();
 		World->CheckIntegrity();
+		double PostLoadTs = FPlatformTime::Seconds();
 
 		// Init the quest manager
 		QuestManager = NewObject<UFlareQuestManager>(this, UFlareQuestManager::StaticClass());
@@ -722,6 +760,9 @@ bool AFlareGame::LoadGame(AFlarePlayerController* PC)
 
 		World->ProcessIncomingPlayerEnemy();
 
+		FLOGV("AFlareGame::LoadGame : save %.2fms, world %.2fms, player and post-load %.2fms, quests %.2fms",
+			(ReadTs - StartTs) * 1000, (WorldTs - ReadTs) * 1000, (PostLoadTs - WorldTs) * 1000, (FPlatformTime::Seconds() - PostLoadTs) * 1000);
+
 		return true;
 	}
 
@@ -752,8 +793,9 @@ protected:
 	void DoWork()
 	{
 		FLOG("Async save start");
+		double StartTs = FPlatformTime::Seconds();
 		SaveSystem->SaveGame(SaveName, SaveData);
-		FLOG("Async save end");
+		FLOGV("Async save end, took %.2fms on worker", (FPlatformTime::Seconds() - StartTs) * 1000);
 	}
 
 	// This next section of code needs to be here.  Not important as to why.
@@ -778,13 +820,16 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 		return true;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_FlareGame_SaveGame);
+	double StartTs = FPlatformTime::Seconds();
+
 	FLOGV("AFlareGame::SaveGame : saving to slot %d", CurrentSaveIndex);
 	UFlareSaveGame* Save = Cast<UFlareSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlareSaveGame::StaticClass()));
 	
 	// Save process
 	if (PC && Save)
 	{
-		// Save the player
+		// Copy the world save data : the world keeps it as the base of the next incremental save
 		PC->Save(Save->PlayerData, Save->PlayerCompanyDescription);
 		Save->WorldData = *World->Save();
 		Save->CurrentImmatriculationIndex = CurrentImmatriculationIndex;
@@ -802,11 +847,24 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 
 		if(Async)
 		{
+			// Serialization, compression and writing happen on the worker
 			(new FAutoDeleteAsyncTask<FAsyncSave>(SaveGameSystem, SaveName, Save))->StartBackgroundTask();
+
+			// Report the game thread cost
+			double SnapshotTime = FPlatformTime::Seconds() - StartTs;
+			if (SnapshotTime > SAVE_GAME_THREAD_BUDGET)
+			{
+				FLOGV("AFlareGame::SaveGame : WARNING save snapshot took %.2fms on game thread (budget is %.2fms)", SnapshotTime * 1000, SAVE_GAME_THREAD_BUDGET * 1000);
+			}
+			else
+			{
+				FLOGV("AFlareGame::SaveGame : save snapshot took %.2fms on game thread", SnapshotTime * 1000);
+			}
 		}
 		else
 		{
 			SaveGameSystem->SaveGame(SaveName, Save);
+			FLOGV("AFlareGame::SaveGame : save took %.2fms", (FPlatformTime::Seconds() - StartTs) * 1000);
 		}
 
 		return true;
@@ -832,6 +890,7 @@ void AFlareGame::UnloadGame()
 		ActiveSector = NULL;
 	}
 	DebrisFieldSystem->Reset();
+	ActorPool->Empty();
 
 	// Cleanup stuff
 	Clean();
@@ -965,7 +1024,12 @@ void AFlareGame::OnLevelLoaded()
 
 		GetPC()->OnSectorActivated(ActiveSector);
 	}
-	GetQuestManager()->OnSectorActivation(ActivatingSector);
+
+	// Quests are notified by Tick once all spacecrafts are spawned
+	if (!ActiveSector || !ActiveSector->IsLoading())
+	{
+		GetQuestManager()->OnSectorActivation(ActivatingSector);
+	}
 
 	ActivatingSector = NULL;
 }
@@ -28,8 +28,10 @@ class UFlareSaveGameSystem;
 class UFlareQuestManager;
 class UFlareQuestCatalog;
 class UFlareDebrisField;
+class UFlareActorPool;
 class UFlareSectorCatalogEntry;
 class UFlareScenarioTools;
+class UFlareSimulationBenchmark;
 struct FFlarePlayerSave;
 
 
@@ -38,13 +40,13 @@ struct FFlareSaveSlotInfo
 {
 	GENERATED_USTRUCT_BODY()
 
-	UPROPERTY() UFlareSaveGame*            Save;
 	UPROPERTY() UMaterialInstanceDynamic*  Emblem;
 
 	FSlateBrush                EmblemBrush;
 
+	bool                       Exists;
 	int32                      CompanyShipCount;
-	int32                      CompanyValue;
+	int64                      CompanyValue;
 	FText                      CompanyName;
 	FName                      UUID;
 };
@@ -201,6 +203,10 @@ protected:
 	UPROPERTY()
 	UFlareDebrisField*                         DebrisFieldSystem;
 
+	/** Recycled shells, bombs and spacecrafts */
+	UPROPERTY()
+	UFlareActorPool*                           ActorPool;
+
 	/** Player controller */
 	UPROPERTY()
 	AFlarePlayerController*			           PlayerController;
@@ -212,6 +218,10 @@ protected:
 	/** Scenario tools */
 	UPROPERTY()
 	UFlareScenarioTools*                       ScenarioTools;
+
+	/** Command line simulation benchmark, waiting for the player controller */
+	UPROPERTY()
+	UFlareSimulationBenchmark*                 SimulationBenchmark;
 	
 	// Post process volume
 	UPROPERTY()
@@ -345,6 +355,11 @@ public:
 		return QuestManager;
 	}
 
+	inline UFlareActorPool* GetActorPool() const
+	{
+		return ActorPool;
+	}
+
 	const FFlareCompanyDescription* GetCompanyDescription(int32 Index) const;
 
 	const FFlareCompanyDescription* GetPlayerCompanyDescription() const;
@@ -441,6 +456,11 @@ public:
 		return ScenarioTools;
 	}
 
+	UFlareSaveGameSystem* GetSaveGameSystem() const
+	{
+		return SaveGameSystem;
+	}
+
 	bool IsLoadingLevel() const
 	{
 		return IsLoadingStreamingLevel;
@@ -6,6 +6,7 @@
 #include "FlareCompany.h"
 #include "FlarePlanetarium.h"
 #include "FlareSectorHelper.h"
+#include "Save/FlareSaveGameSystem.h"
 
 #include "../Data/FlareFactoryCatalogEntry.h"
 #include "../Data/FlareResourceCatalog.h"
@@ -14,6 +15,7 @@
 
 #include "../Economy/FlareCargoBay.h"
 
+#include "../Player/FlareHUD.h"
 #include "../Player/FlareMenuManager.h"
 #include "../Player/FlarePlayerController.h"
 
@@ -175,6 +177,25 @@ void UFlareGameTools::TakeHighResScreenShot()
 	GetPC()->TakeHighResScreenshot();
 }
 
+void UFlareGameTools::ConvertSaveSlot(int32 Index, bool Binary)
+{
+	FString SaveFile = "SaveSlot" + FString::FromInt(Index);
+	UFlareSaveGameSystem* SaveGameSystem = GetGame()->GetSaveGameSystem();
+
+	if (!SaveGameSystem->DoesSaveGameExist(SaveFile))
+	{
+		FLOGV("UFlareGameTools::ConvertSaveSlot failed: no save in slot %d", Index);
+		return;
+	}
+
+	SaveGameSystem->ConvertGame(SaveFile, Binary ? EFlareSaveFormat::Binary : EFlareSaveFormat::Json);
+}
+
+void UFlareGameTools::SetBinarySaves(bool Binary)
+{
+	GetGame()->GetSaveGameSystem()->SetSaveFormat(Binary ? EFlareSaveFormat::Binary : EFlareSaveFormat::Json);
+}
+
 
 #define RESET   "\033[0m"
 #define RED     "\033[31m"      /* Red */
@@ -375,7 +396,7 @@ void UFlareGameTools::PrintEconomyStatus()
 	FLOG("=============");
 	FLOG("");
 
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
 	WorldStats = WorldHelper::ComputeWorldResourceStats(GetGame());
 
 
@@ -384,19 +405,19 @@ void UFlareGameTools::PrintEconomyStatus()
 	{
 		FFlareResourceDescription* Resource = &ResourceEntries[ResourceIndex]->Data;
 
-		if (WorldStats.Contains(Resource))
+		if (WorldStats.IsValidIndex(Resource->Index))
 		{
 			FLOGV("Resource '%s'", *Resource->Name.ToString());
-			FLOGV("- Stock: %d", WorldStats[Resource].Stock);
-			FLOGV("- Production: %.2f", WorldStats[Resource].Production);
-			FLOGV("- Consumption: %.2f", WorldStats[Resource].Consumption);
-			if(WorldStats[Resource].Balance < 0)
+			FLOGV("- Stock: %d", WorldStats[Resource->Index].Stock);
+			FLOGV("- Production: %.2f", WorldStats[Resource->Index].Production);
+			FLOGV("- Consumption: %.2f", WorldStats[Resource->Index].Consumption);
+			if(WorldStats[Resource->Index].Balance < 0)
 			{
-				FLOGV("- " RED "Balance: %.2f" RESET, WorldStats[Resource].Balance);
+				FLOGV("- " RED "Balance: %.2f" RESET, WorldStats[Resource->Index].Balance);
 			}
 			else
 			{
-				FLOGV("- Balance: %.2f", WorldStats[Resource].Balance);
+				FLOGV("- Balance: %.2f", WorldStats[Resource->Index].Balance);
 			}
 		}
 	}
@@ -534,6 +555,25 @@ void UFlareGameTools::Simulate()
 	GetGame()->ActivateCurrentSector();
 }
 
+void UFlareGameTools::SimulateDays(int32 DayCount)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("AFlareGame::SimulateDays failed: no loaded world");
+		return;
+	}
+
+	if (GetActiveSector())
+	{
+		FLOG("AFlareGame::SimulateDays failed: a sector is active");
+		return;
+	}
+
+	GetGame()->DeactivateSector();
+	GetGameWorld()->SimulateDays(DayCount);
+	GetGame()->ActivateCurrentSector();
+}
+
 void UFlareGameTools::SetPlanatariumTimeMultiplier(float Multiplier)
 {
 	GetGame()->GetPlanetarium()->SetTimeMultiplier(Multiplier);
@@ -561,6 +601,32 @@ void UFlareGameTools::SetFastFastForward(bool FFF)
 	FastFastForward = FFF;
 }
 
+void UFlareGameTools::ToggleSimulationProfile()
+{
+	GetPC()->GetNavHUD()->ToggleSimulationProfile();
+}
+
+void UFlareGameTools::DumpSimulationProfile()
+{
+	if (!GetGameWorld())
+	{
+		FLOG("AFlareGame::DumpSimulationProfile failed: no loaded world");
+		return;
+	}
+
+	FFlareSimulationProfiler& Profiler = GetGameWorld()->GetSimulationProfiler();
+	FString FileName = FString::Printf(TEXT("%s/SimulationProfile-%s.csv"), *FPaths::GameSavedDir(), *FDateTime::Now().ToString());
+
+	if (Profiler.SaveCSV(FileName))
+	{
+		FLOGV("AFlareGame::DumpSimulationProfile : %d days written to '%s'", Profiler.Num(), *FileName);
+	}
+	else
+	{
+		FLOGV("AFlareGame::DumpSimulationProfile failed: can't write '%s'", *FileName);
+	}
+}
+
 /*----------------------------------------------------
 	Company tools
 ----------------------------------------------------*/
@@ -1335,7 +1401,7 @@ void UFlareGameTools::PrintCargoBay(FName ShipImmatriculation)
 	FLOGV("Cargo bay for '%s' : ", *ShipImmatriculation.ToString());
 	for (int32 CargoIndex = 0; CargoIndex < CargoBay->GetSlotCount(); CargoIndex++)
 	{
-		FFlareCargo* Cargo = CargoBay->GetSlot(CargoIndex);
+		const FFlareCargo* Cargo = CargoBay->GetSlot(CargoIndex);
 		FLOGV("  - %s : %u / %u ", (Cargo->Resource ? *Cargo->Resource->Name.ToString() : TEXT("[Empty]")), Cargo->Quantity, CargoBay->GetSlotCapacity());
 	}
 }
@@ -68,6 +68,14 @@ public:
 	UFUNCTION(exec)
 	void TakeHighResScreenShot();
 
+	/** Convert a save slot to the binary or JSON format */
+	UFUNCTION(exec)
+	void ConvertSaveSlot(int32 Index, bool Binary);
+
+	/** Use the binary or JSON format for new saves */
+	UFUNCTION(exec)
+	void SetBinarySaves(bool Binary);
+
 	/*----------------------------------------------------
 		World tools
 	----------------------------------------------------*/
@@ -84,6 +92,10 @@ public:
 	UFUNCTION(exec)
 	void Simulate();
 
+	/** Simulate several days in batch mode */
+	UFUNCTION(exec)
+	void SimulateDays(int32 DayCount);
+
 	/** Configure time multiplier for active sector planetarium */
 	UFUNCTION(exec)
 	void SetPlanatariumTimeMultiplier(float Multiplier);
@@ -95,6 +107,14 @@ public:
 	UFUNCTION(exec)
 	void SetFastFastForward(bool FFF);
 
+	/** Show the timings of the last simulated day on the HUD */
+	UFUNCTION(exec)
+	void ToggleSimulationProfile();
+
+	/** Write the timings of the last simulated days to Saved/SimulationProfile-<date>.csv */
+	UFUNCTION(exec)
+	void DumpSimulationProfile();
+
 	/*----------------------------------------------------
 		Company tools
 	----------------------------------------------------*/
@@ -4,9 +4,16 @@
 #include "../Flare.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
 
+#include "Serialization/CustomVersion.h"
+
 #define LOCTEXT_NAMESPACE "FlareNavigationHUD"
 
 
+const FGuid FFlareBundleVersion::GUID(0x6A3C1F52, 0x94D84E1B, 0xB2E7C0A5, 0x3F9D6E21);
+
+static FCustomVersionRegistration GRegisterFlareBundleVersion(FFlareBundleVersion::GUID, FFlareBundleVersion::LatestVersion, TEXT("FlareBundle"));
+
+
 /*----------------------------------------------------
 	Constructor
 ----------------------------------------------------*/
@@ -165,136 +172,146 @@ float FFlareFloatBuffer::GetMean(int32 StartAge, int32 EndAge)
 
 bool FFlareBundle::HasFloat(FName Key) const
 {
-	return FloatValues.Contains(Key);
+	return Find(Key, EFlareBundleType::Float) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasInt32(FName Key) const
 {
-	return Int32Values.Contains(Key);
+	return Find(Key, EFlareBundleType::Int32) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasTransform(FName Key) const
 {
-	return TransformValues.Contains(Key);
+	return Find(Key, EFlareBundleType::Transform) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasVectorArray(FName Key) const
 {
-	return VectorArrayValues.Contains(Key);
+	return Find(Key, EFlareBundleType::VectorArray) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasName(FName Key) const
 {
-	return NameValues.Contains(Key);
+	return Find(Key, EFlareBundleType::Name) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasNameArray(FName Key) const
 {
-	return NameArrayValues.Contains(Key);
+	return Find(Key, EFlareBundleType::NameArray) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasString(FName Key) const
 {
-	return StringValues.Contains(Key);
+	return Find(Key, EFlareBundleType::String) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasTag(FName Tag) const
 {
-	return Tags.Contains(Tag);
+	return Find(Tag, EFlareBundleType::Tag) != INDEX_NONE;
 }
 
 bool FFlareBundle::HasPtr(FName Key) const
 {
-	return PtrValues.Contains(Key);
+	return Find(Key, EFlareBundleType::Ptr) != INDEX_NONE;
 }
 
 float FFlareBundle::GetFloat(FName Key, float Default) const
 {
-	if(FloatValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::Float);
+	if (Index != INDEX_NONE)
 	{
-		return FloatValues[Key];
+		return Entries[Index].FloatValue;
 	}
 	return Default;
 }
 
 int32 FFlareBundle::GetInt32(FName Key, int32 Default) const
 {
-	if(Int32Values.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::Int32);
+	if (Index != INDEX_NONE)
 	{
-		return Int32Values[Key];
+		return Entries[Index].Int32Value;
 	}
 	return Default;
 }
 
 FTransform FFlareBundle::GetTransform(FName Key, const FTransform Default) const
 {
-	if(TransformValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::Transform);
+	if (Index != INDEX_NONE)
 	{
-		return TransformValues[Key];
+		return TransformValues[Entries[Index].ValueIndex];
 	}
 	return Default;
 }
 
 TArray<FVector> FFlareBundle::GetVectorArray(FName Key) const
 {
-	if(VectorArrayValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::VectorArray);
+	if (Index != INDEX_NONE)
 	{
-		return VectorArrayValues[Key].Entries;
+		return VectorArrayValues[Entries[Index].ValueIndex].Entries;
 	}
 	return TArray<FVector>();
 }
 
 FName FFlareBundle::GetName(FName Key) const
 {
-	if(NameValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::Name);
+	if (Index != INDEX_NONE)
 	{
-		return NameValues[Key];
+		return Entries[Index].NameValue;
 	}
 	return "";
 }
 
 TArray<FName> FFlareBundle::GetNameArray(FName Key) const
 {
-	if(NameArrayValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::NameArray);
+	if (Index != INDEX_NONE)
 	{
-		return NameArrayValues[Key].Entries;
+		return NameArrayValues[Entries[Index].ValueIndex].Entries;
 	}
 	return TArray<FName>();
 }
 
 FString FFlareBundle::GetString(FName Key) const
 {
-	if (StringValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::String);
+	if (Index != INDEX_NONE)
 	{
-		return StringValues[Key];
+		return StringValues[Entries[Index].ValueIndex];
 	}
 	return "";
 }
 
 void* FFlareBundle::GetPtr(FName Key) const
 {
-	if (PtrValues.Contains(Key))
+	int32 Index = Find(Key, EFlareBundleType::Ptr);
+	if (Index != INDEX_NONE)
 	{
-		return PtrValues[Key].Entry;
+		return Entries[Index].PtrValue;
 	}
 	return NULL;
 }
 
 FFlareBundle& FFlareBundle::PutFloat(FName Key, float Value)
 {
-	FloatValues.Add(Key, Value);
+	bool Added;
+	FindOrAdd(Key, EFlareBundleType::Float, Added).FloatValue = Value;
 	return *this;
 }
 
 FFlareBundle& FFlareBundle::PutInt32(FName Key, int32 Value)
 {
-	Int32Values.Add(Key, Value);
+	bool Added;
+	FindOrAdd(Key, EFlareBundleType::Int32, Added).Int32Value = Value;
 	return *this;
 }
 
 FFlareBundle& FFlareBundle::PutTransform(FName Key, const FTransform Value)
 {
-	TransformValues.Add(Key, Value);
+	PutIndexedValue(Key, EFlareBundleType::Transform, TransformValues, Value);
 	return *this;
 }
 
@@ -302,13 +319,14 @@ FFlareBundle& FFlareBundle::PutVectorArray(FName Key, const TArray<FVector> Valu
 {
 	FVectorArray Array;
 	Array.Entries = Value;
-	VectorArrayValues.Add(Key, Array);
+	PutIndexedValue(Key, EFlareBundleType::VectorArray, VectorArrayValues, Array);
 	return *this;
 }
 
 FFlareBundle& FFlareBundle::PutName(FName Key, FName Value)
 {
-	NameValues.Add(Key, Value);
+	bool Added;
+	FindOrAdd(Key, EFlareBundleType::Name, Added).NameValue = Value;
 	return *this;
 }
 
@@ -316,42 +334,260 @@ FFlareBundle& FFlareBundle::PutNameArray(FName Key, const TArray<FName> Value)
 {
 	FNameArray Array;
 	Array.Entries = Value;
-	NameArrayValues.Add(Key, Array);
+	PutIndexedValue(Key, EFlareBundleType::NameArray, NameArrayValues, Array);
 	return *this;
 }
 
 FFlareBundle& FFlareBundle::PutString(FName Key, FString Value)
 {
-	StringValues.Add(Key, Value);
+	PutIndexedValue(Key, EFlareBundleType::String, StringValues, Value);
 	return *this;
 }
 
 FFlareBundle& FFlareBundle::PutTag(FName Tag)
 {
-	Tags.Add(Tag);
+	bool Added;
+	FindOrAdd(Tag, EFlareBundleType::Tag, Added);
 	return *this;
 }
 
 
 FFlareBundle& FFlareBundle::PutPtr(FName Key, void* Value)
 {
-	FPtr Ptr;
-	Ptr.Entry = Value;
-	PtrValues.Add(Key, Ptr);
+	bool Added;
+	FindOrAdd(Key, EFlareBundleType::Ptr, Added).PtrValue = Value;
 	return *this;
 }
 
+TArray<FName> FFlareBundle::GetKeys(EFlareBundleType::Type Type) const
+{
+	TArray<FName> Keys;
+	for (const FFlareBundleEntry& Entry : Entries)
+	{
+		if (Entry.Type == Type)
+		{
+			Keys.Add(Entry.Key);
+		}
+	}
+	return Keys;
+}
+
 void FFlareBundle::Clear()
 {
-	FloatValues.Empty();
-	Int32Values.Empty();
+	Entries.Empty();
 	TransformValues.Empty();
 	VectorArrayValues.Empty();
-	NameValues.Empty();
 	NameArrayValues.Empty();
 	StringValues.Empty();
-	Tags.Empty();
-	PtrValues.Empty();
+}
+
+bool FFlareBundle::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FFlareBundleVersion::GUID);
+
+	// Older saves hold tagged properties that don't exist anymore : let the engine skip them
+	if (Ar.IsLoading())
+	{
+		const FCustomVersion* Version = Ar.GetCustomVersions().GetVersion(FFlareBundleVersion::GUID);
+		if (!Version || Version->Version < FFlareBundleVersion::NativeSerializer)
+		{
+			return false;
+		}
+	}
+
+	if (Ar.IsSaving())
+	{
+		int32 Count = 0;
+		for (const FFlareBundleEntry& Entry : Entries)
+		{
+			Count += (Entry.Type != EFlareBundleType::Ptr);
+		}
+		Ar << Count;
+
+		for (FFlareBundleEntry& Entry : Entries)
+		{
+			if (Entry.Type == EFlareBundleType::Ptr)
+			{
+				continue;
+			}
+
+			uint8 Type = Entry.Type;
+			Ar << Entry.Key;
+			Ar << Type;
+
+			switch (Entry.Type)
+			{
+				case EFlareBundleType::Float:       Ar << Entry.FloatValue;                                  break;
+				case EFlareBundleType::Int32:       Ar << Entry.Int32Value;                                  break;
+				case EFlareBundleType::Transform:   Ar << TransformValues[Entry.ValueIndex];                 break;
+				case EFlareBundleType::VectorArray: Ar << VectorArrayValues[Entry.ValueIndex].Entries;       break;
+				case EFlareBundleType::Name:        Ar << Entry.NameValue;                                   break;
+				case EFlareBundleType::NameArray:   Ar << NameArrayValues[Entry.ValueIndex].Entries;         break;
+				case EFlareBundleType::String:      Ar << StringValues[Entry.ValueIndex];                    break;
+				default:                                                                                     break;
+			}
+		}
+	}
+	else
+	{
+		// Entries are sorted by name index, which changes between sessions : insert them again
+		Clear();
+
+		int32 Count = 0;
+		Ar << Count;
+
+		for (int32 Index = 0; Index < Count && !Ar.IsError(); Index++)
+		{
+			FName Key;
+			uint8 Type = 0;
+			Ar << Key;
+			Ar << Type;
+
+			switch (Type)
+			{
+				case EFlareBundleType::Float:
+				{
+					float Value = 0;
+					Ar << Value;
+					PutFloat(Key, Value);
+					break;
+				}
+				case EFlareBundleType::Int32:
+				{
+					int32 Value = 0;
+					Ar << Value;
+					PutInt32(Key, Value);
+					break;
+				}
+				case EFlareBundleType::Transform:
+				{
+					FTransform Value;
+					Ar << Value;
+					PutTransform(Key, Value);
+					break;
+				}
+				case EFlareBundleType::VectorArray:
+				{
+					TArray<FVector> Value;
+					Ar << Value;
+					PutVectorArray(Key, Value);
+					break;
+				}
+				case EFlareBundleType::Name:
+				{
+					FName Value;
+					Ar << Value;
+					PutName(Key, Value);
+					break;
+				}
+				case EFlareBundleType::NameArray:
+				{
+					TArray<FName> Value;
+					Ar << Value;
+					PutNameArray(Key, Value);
+					break;
+				}
+				case EFlareBundleType::String:
+				{
+					FString Value;
+					Ar << Value;
+					PutString(Key, Value);
+					break;
+				}
+				case EFlareBundleType::Tag:
+				{
+					PutTag(Key);
+					break;
+				}
+				default:
+				{
+					FLOGV("FFlareBundle::Serialize : unknown value type %d for '%s'", Type, *Key.ToString());
+					Ar.SetError();
+					break;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FFlareBundle::Find(FName Key, EFlareBundleType::Type Type) const
+{
+	int32 Index = LowerBound(Key, Type);
+	if (Index < Entries.Num() && Entries[Index].Key == Key && Entries[Index].Type == Type)
+	{
+		return Index;
+	}
+	return INDEX_NONE;
+}
+
+int32 FFlareBundle::LowerBound(FName Key, EFlareBundleType::Type Type) const
+{
+	// Order by name index rather than by string, this only needs to be stable during a session
+	auto IsBefore = [&](const FFlareBundleEntry& Entry)
+	{
+		if (Entry.Key.GetComparisonIndex() != Key.GetComparisonIndex())
+		{
+			return Entry.Key.GetComparisonIndex() < Key.GetComparisonIndex();
+		}
+		else if (Entry.Key.GetNumber() != Key.GetNumber())
+		{
+			return Entry.Key.GetNumber() < Key.GetNumber();
+		}
+		return Entry.Type < Type;
+	};
+
+	int32 Min = 0;
+	int32 Max = Entries.Num();
+	while (Min < Max)
+	{
+		int32 Middle = (Min + Max) / 2;
+		if (IsBefore(Entries[Middle]))
+		{
+			Min = Middle + 1;
+		}
+		else
+		{
+			Max = Middle;
+		}
+	}
+
+	return Min;
+}
+
+FFlareBundleEntry& FFlareBundle::FindOrAdd(FName Key, EFlareBundleType::Type Type, bool& Added)
+{
+	int32 Index = LowerBound(Key, Type);
+	Added = !(Index < Entries.Num() && Entries[Index].Key == Key && Entries[Index].Type == Type);
+
+	if (Added)
+	{
+		FFlareBundleEntry Entry;
+		Entry.Key = Key;
+		Entry.Type = Type;
+		Entry.NameValue = NAME_None;
+		Entry.PtrValue = NULL;
+		Entries.Insert(Entry, Index);
+	}
+
+	return Entries[Index];
+}
+
+template <typename ValueType>
+void FFlareBundle::PutIndexedValue(FName Key, EFlareBundleType::Type Type, TArray<ValueType>& Values, const ValueType& Value)
+{
+	bool Added;
+	FFlareBundleEntry& Entry = FindOrAdd(Key, Type, Added);
+
+	if (Added)
+	{
+		Entry.ValueIndex = Values.Add(Value);
+	}
+	else
+	{
+		Values[Entry.ValueIndex] = Value;
+	}
 }
 
 DamageCause::DamageCause():
@@ -168,15 +168,26 @@ struct FFlareCompanyAISave
 {
 	GENERATED_USTRUCT_BODY()
 
+	UPROPERTY(EditAnywhere, Category = Save)
 	int64 BudgetTechnology;
+
+	UPROPERTY(EditAnywhere, Category = Save)
 	int64 BudgetMilitary;
+
+	UPROPERTY(EditAnywhere, Category = Save)
 	int64 BudgetStation;
+
+	UPROPERTY(EditAnywhere, Category = Save)
 	int64 BudgetTrade;
 
 	/* Modify AttackThreshold */
+	UPROPERTY(EditAnywhere, Category = Save)
 	float Caution;
+
+	UPROPERTY(EditAnywhere, Category = Save)
 	float Pacifism;
 
+	UPROPERTY(EditAnywhere, Category = Save)
 	FName ResearchProject;
 };
 
@@ -255,6 +266,7 @@ struct FFlareCompanySave
 	int64 PlayerLastWarDate;
 
 	/** Modify reputation to this company */
+	UPROPERTY(EditAnywhere, Category = Save)
 	float Shame;
 
 	/** Unlocked technologies */
@@ -339,6 +351,10 @@ struct FFlareIncomingEvent
 	/** Days until event */
 	UPROPERTY(EditAnywhere, Category = Content)
 	int64 RemainingDuration;
+
+	/** Source of the event, kept from one day to the next */
+	UPROPERTY(EditAnywhere, Category = Content)
+	FName Identifier;
 };
 
 
@@ -448,38 +464,61 @@ struct FPtr
 	void* Entry;
 };
 
-/** Generic storage system */
-USTRUCT()
-struct FFlareBundle
+/** Bundle value type */
+namespace EFlareBundleType
 {
-	GENERATED_USTRUCT_BODY()
-
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, float> FloatValues;
-
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, int32> Int32Values;
+	enum Type
+	{
+		Float,
+		Int32,
+		Transform,
+		VectorArray,
+		Name,
+		NameArray,
+		String,
+		Tag,
+		Ptr
+	};
+}
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FTransform> TransformValues;
+/** Versions of the binary bundle format */
+struct FFlareBundleVersion
+{
+	enum Type
+	{
+		// Tagged properties, from before the bundle had native serialization
+		TaggedProperties = 0,
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FVectorArray> VectorArrayValues;
+		// Entries written by FFlareBundle::Serialize
+		NativeSerializer,
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FNameArray> NameArrayValues;
+		LatestVersion = NativeSerializer
+	};
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FName> NameValues;
+	static const FGuid GUID;
+};
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FString> StringValues;
+/** Bundle value. Scalars are stored in place, other values in the typed arrays of the bundle. */
+struct FFlareBundleEntry
+{
+	FName                                          Key;
+	EFlareBundleType::Type                         Type;
+	FName                                          NameValue;
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TArray<FName> Tags;
+	union
+	{
+		float                                      FloatValue;
+		int32                                      Int32Value;
+		int32                                      ValueIndex;
+		void*                                      PtrValue;
+	};
+};
 
-	UPROPERTY(EditAnywhere, Category = Save)
-	TMap<FName, FPtr> PtrValues;
+/** Generic storage system */
+USTRUCT()
+struct FFlareBundle
+{
+	GENERATED_USTRUCT_BODY()
 
 	bool HasFloat(FName Key) const;
 	bool HasInt32(FName Key) const;
@@ -511,7 +550,45 @@ struct FFlareBundle
 	FFlareBundle& PutTag(FName Tag);
 	FFlareBundle& PutPtr(FName Key, void* Value);
 
+	/** Get the keys of all values of a type */
+	TArray<FName> GetKeys(EFlareBundleType::Type Type) const;
+
 	void Clear();
+
+	/** Binary serialization, for the binary save format. Pointers are not saved. */
+	bool Serialize(FArchive& Ar);
+
+protected:
+
+	/** Get the index of a value, or INDEX_NONE */
+	int32 Find(FName Key, EFlareBundleType::Type Type) const;
+
+	/** Get the index of a value, or the index where it would be inserted */
+	int32 LowerBound(FName Key, EFlareBundleType::Type Type) const;
+
+	/** Get a value, inserting it if needed */
+	FFlareBundleEntry& FindOrAdd(FName Key, EFlareBundleType::Type Type, bool& Added);
+
+	/** Set a value stored in a typed array */
+	template <typename ValueType>
+	void PutIndexedValue(FName Key, EFlareBundleType::Type Type, TArray<ValueType>& Values, const ValueType& Value);
+
+	// Values sorted by key and type, most bundles fit in the inline buffer
+	TArray<FFlareBundleEntry, TInlineAllocator<4>> Entries;
+
+	TArray<FTransform>                             TransformValues;
+	TArray<FVectorArray>                           VectorArrayValues;
+	TArray<FNameArray>                             NameArrayValues;
+	TArray<FString>                                StringValues;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFlareBundle> : public TStructOpsTypeTraitsBase2<FFlareBundle>
+{
+	enum
+	{
+		WithSerializer = true
+	};
 };
 
 struct DamageCause
@@ -3,16 +3,27 @@
 #include "../Flare.h"
 
 #include "FlareGame.h"
+#include "FlareActorPool.h"
 #include "FlarePlanetarium.h"
 #include "FlareSimulatedSector.h"
 #include "FlareCollider.h"
 
+#include "EngineUtils.h"
+
 #include "../Player/FlarePlayerController.h"
 
 #include "../Spacecrafts/FlareShell.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateBroadphase"), STAT_FlareSector_UpdateBroadphase, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector ContinueLoading"), STAT_FlareSector_ContinueLoading, STATGROUP_Flare);
+
+
+// Time allowed each frame to spawn the pending spacecrafts, in ms
+#define SECTOR_LOADING_BUDGET 4.0
+
+
 /*----------------------------------------------------
 	Constructor
 ----------------------------------------------------*/
@@ -21,7 +32,12 @@ UFlareSector::UFlareSector(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	SectorRepartitionCache = false;
+	SectorBroadphaseCache = false;
+	SectorBroadphaseFrame = 0;
 	IsDestroyingSector = false;
+	IsSectorLoading = false;
+	IsSectorPaused = false;
+	PendingSpacecraftIndex = 0;
 }
 
 /*----------------------------------------------------
@@ -49,47 +65,136 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 		}
 	}
 
-	// Load safe location spacecrafts
+	// Stations and player spacecrafts are needed right away, other ships are spawned over the next frames
+	TArray<UFlareSimulatedSpacecraft*> SafeSpacecrafts;
+	TArray<UFlareSimulatedSpacecraft*> UnsafeSpacecrafts;
 	for (int i = 0 ; i < ParentSector->GetSectorSpacecrafts().Num(); i++)
 	{
 		UFlareSimulatedSpacecraft* Spacecraft = ParentSector->GetSectorSpacecrafts()[i];
-		if (Spacecraft->GetData().SpawnMode == EFlareSpawnMode::Safe && (!Spacecraft->IsReserve() ||  Parent->GetGame()->GetPC()->GetPlayerShip() == Spacecraft))
+		bool IsPlayerShip = (Parent->GetGame()->GetPC()->GetPlayerShip() == Spacecraft);
+
+		if (Spacecraft->IsReserve() && !IsPlayerShip)
 		{
-			LoadSpacecraft(Spacecraft);
+			continue;
+		}
+		else if (Spacecraft->IsStation() || IsPlayerShip || Spacecraft->GetCompany() == Parent->GetGame()->GetPC()->GetCompany())
+		{
+			(Spacecraft->GetData().SpawnMode == EFlareSpawnMode::Safe ? SafeSpacecrafts : UnsafeSpacecrafts).Add(Spacecraft);
+		}
+		else if (Spacecraft->GetData().SpawnMode == EFlareSpawnMode::Safe)
+		{
+			PendingSpacecrafts.Add(Spacecraft);
 		}
 	}
 
+	// Unsafe ships are placed around the safe ones, so they come last
+	for (int i = 0; i < ParentSector->GetSectorSpacecrafts().Num(); i++)
+	{
+		UFlareSimulatedSpacecraft* Spacecraft = ParentSector->GetSectorSpacecrafts()[i];
+		if (Spacecraft->GetData().SpawnMode != EFlareSpawnMode::Safe && !Spacecraft->IsReserve()
+		 && !Spacecraft->IsStation() && Spacecraft->GetCompany() != Parent->GetGame()->GetPC()->GetCompany())
+		{
+			PendingSpacecrafts.Add(Spacecraft);
+		}
+	}
+
+	// Load safe location spacecrafts
+	for (UFlareSimulatedSpacecraft* Spacecraft : SafeSpacecrafts)
+	{
+		LoadSpacecraft(Spacecraft);
+	}
+
 	SectorRepartitionCache = false;
 
 	// Load unsafe location spacecrafts
-	for (int i = 0; i < ParentSector->GetSectorSpacecrafts().Num(); i++)
+	for (UFlareSimulatedSpacecraft* Spacecraft : UnsafeSpacecrafts)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = ParentSector->GetSectorSpacecrafts()[i];
-		if (Spacecraft->GetData().SpawnMode != EFlareSpawnMode::Safe && (!Spacecraft->IsReserve() ||  Parent->GetGame()->GetPC()->GetPlayerShip() == Spacecraft))
+		LoadSpacecraft(Spacecraft);
+	}
+
+	FLOGV("UFlareSector::Load : %d spacecrafts loaded, %d pending", SectorSpacecrafts.Num(), PendingSpacecrafts.Num());
+
+	// Bombs are loaded with the last spacecrafts
+	IsSectorLoading = true;
+	PendingSpacecraftIndex = 0;
+	ContinueLoading();
+}
+
+bool UFlareSector::ContinueLoading()
+{
+	if (!IsSectorLoading)
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_ContinueLoading);
+	double StartTime = FPlatformTime::Seconds();
+
+	// Spawn at least one spacecraft each frame so that loading always completes
+	while (PendingSpacecraftIndex < PendingSpacecrafts.Num())
+	{
+		UFlareSimulatedSpacecraft* Spacecraft = PendingSpacecrafts[PendingSpacecraftIndex];
+		PendingSpacecraftIndex++;
+
+		// The simulation may have moved the spacecraft since the sector was activated
+		if (Spacecraft->GetCurrentSector() == ParentSector && !Spacecraft->IsActive())
 		{
-			LoadSpacecraft(Spacecraft);
+			// Unsafe ships are placed around the ships already there
+			if (Spacecraft->GetData().SpawnMode == EFlareSpawnMode::Safe)
+			{
+				SectorRepartitionCache = false;
+			}
+
+			AFlareSpacecraft* NewSpacecraft = LoadSpacecraft(Spacecraft);
+			if (NewSpacecraft && IsSectorPaused)
+			{
+				NewSpacecraft->SetPause(true);
+			}
+		}
+
+		if ((FPlatformTime::Seconds() - StartTime) * 1000 > SECTOR_LOADING_BUDGET)
+		{
+			break;
 		}
 	}
 
-	// Load bombs
-	for (int i = 0; i < ParentSector->GetData()->BombData.Num(); i++)
+	// All spacecrafts are there, load bombs
+	if (PendingSpacecraftIndex >= PendingSpacecrafts.Num())
 	{
-		LoadBomb(ParentSector->GetData()->BombData[i]);
+		for (int i = 0; i < ParentSector->GetData()->BombData.Num(); i++)
+		{
+			AFlareBomb* Bomb = LoadBomb(ParentSector->GetData()->BombData[i]);
+			if (Bomb && IsSectorPaused)
+			{
+				Bomb->SetPause(true);
+			}
+		}
+
+		FLOGV("UFlareSector::ContinueLoading : '%s' loaded with %d spacecrafts", *ParentSector->GetSectorName().ToString(), SectorSpacecrafts.Num());
+
+		PendingSpacecrafts.Empty();
+		PendingSpacecraftIndex = 0;
+		IsSectorLoading = false;
 	}
+
+	return !IsSectorLoading;
 }
 
 void UFlareSector::Save()
 {
 	FFlareSectorSave* SectorData  = GetSimulatedSector()->GetData();
 
-	SectorData->BombData.Empty();
 	SectorData->AsteroidData.Empty();
 	// Meteorites have references but save must be call
 
-
-	for (int i = 0 ; i < SectorBombs.Num(); i++)
+	// Bombs are spawned last, keep the saved ones until then
+	if (!IsSectorLoading)
 	{
-		SectorData->BombData.Add(*SectorBombs[i]->Save());
+		SectorData->BombData.Empty();
+		for (int i = 0 ; i < SectorBombs.Num(); i++)
+		{
+			SectorData->BombData.Add(*SectorBombs[i]->Save());
+		}
 	}
 
 	for (int i = 0 ; i < SectorAsteroids.Num(); i++)
@@ -111,15 +216,16 @@ void UFlareSector::DestroySector()
 
 	IsDestroyingSector = true;
 
-	// Remove spacecrafts from world
-	for (int SpacecraftIndex = 0 ; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
+	// Bombs, spacecrafts and shells go back to the actor pool for the next sector
+	UFlareActorPool* ActorPool = GetGame()->GetActorPool();
+	for (int BombIndex = 0 ; BombIndex < SectorBombs.Num(); BombIndex++)
 	{
-		SectorSpacecrafts[SpacecraftIndex]->Destroy();
+		SectorBombs[BombIndex]->Recycle();
 	}
 
-	for (int BombIndex = 0 ; BombIndex < SectorBombs.Num(); BombIndex++)
+	for (int SpacecraftIndex = 0 ; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
 	{
-		SectorBombs[BombIndex]->Destroy();
+		ActorPool->ReleaseSpacecraft(SectorSpacecrafts[SpacecraftIndex]);
 	}
 
 	for (int AsteroidIndex = 0 ; AsteroidIndex < SectorAsteroids.Num(); AsteroidIndex++)
@@ -134,7 +240,7 @@ void UFlareSector::DestroySector()
 
 	for (int ShellIndex = 0 ; ShellIndex < SectorShells.Num(); ShellIndex++)
 	{
-		SectorShells[ShellIndex]->Destroy();
+		SectorShells[ShellIndex]->Recycle();
 	}
 
 	SectorSpacecrafts.Empty();
@@ -144,7 +250,12 @@ void UFlareSector::DestroySector()
 	SectorAsteroids.Empty();
 	SectorMeteorites.Empty();
 	SectorShells.Empty();
+	SectorBroadphase.Reset();
+	SectorBroadphaseCache = false;
 
+	PendingSpacecrafts.Empty();
+	PendingSpacecraftIndex = 0;
+	IsSectorLoading = false;
 	IsDestroyingSector = false;
 }
 
@@ -163,6 +274,7 @@ AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidDat
     Asteroid->Load(AsteroidData);
 
 	SectorAsteroids.AddUnique(Asteroid);
+	SectorBroadphaseCache = false;
     return Asteroid;
 }
 
@@ -176,6 +288,7 @@ AFlareMeteorite* UFlareSector::LoadMeteorite(FFlareMeteoriteSave& MeteoriteData)
 	Meteorite->Load(&MeteoriteData, this);
 
 	SectorMeteorites.AddUnique(Meteorite);
+	SectorBroadphaseCache = false;
 	return Meteorite;
 }
 
@@ -197,7 +310,7 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
 	// Create and configure the ship
-	AFlareSpacecraft* Spacecraft = GetGame()->GetWorld()->SpawnActor<AFlareSpacecraft>(ParentSpacecraft->GetDescription()->SpacecraftTemplate,
+	AFlareSpacecraft* Spacecraft = GetGame()->GetActorPool()->AcquireSpacecraft(ParentSpacecraft,
 		ParentSpacecraft->GetData().Location,
 		ParentSpacecraft->GetData().Rotation,
 		Params);
@@ -207,16 +320,6 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 		Spacecraft->Load(ParentSpacecraft);
 		UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(Spacecraft->GetRootComponent());
 
-		if (Spacecraft->IsStation())
-		{
-			SectorStations.Add(Spacecraft);
-		}
-		else
-		{
-			SectorShips.Add(Spacecraft);
-		}
-		SectorSpacecrafts.Add(Spacecraft);
-
 		switch (ParentSpacecraft->GetData().SpawnMode)
 		{
 			// Already known to be correct
@@ -347,6 +450,24 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 			break;
 		}
 
+		// Register the spacecraft once placed, so that placement doesn't collide with itself
+		if (Spacecraft->IsStation())
+		{
+			SectorStations.Add(Spacecraft);
+		}
+		else
+		{
+			SectorShips.Add(Spacecraft);
+		}
+		SectorSpacecrafts.Add(Spacecraft);
+
+		// Keep this frame's broadphase up to date instead of rebuilding it for each loaded spacecraft
+		if (SectorBroadphaseCache && SectorBroadphaseFrame == GFrameCounter)
+		{
+			SectorBroadphase.Add(Spacecraft, Spacecraft->GetActorLocation(), RootComponent->GetPhysicsLinearVelocity(),
+				Spacecraft->GetMeshScale(), EFlareBroadphaseType::Spacecraft);
+		}
+
 		if (ParentSpacecraft->GetData().SpawnMode == EFlareSpawnMode::Travel && GetSimulatedSector()->IsTravelSector())
 		{
 			FLOG("UFlareSector::LoadSpacecraft : ship is still traveling");
@@ -403,7 +524,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
             Params.bNoFail = true;
 
             // Create and configure the ship
-			Bomb = GetGame()->GetWorld()->SpawnActor<AFlareBomb>(AFlareBomb::StaticClass(), BombData.Location, BombData.Rotation, Params);
+			Bomb = GetGame()->GetActorPool()->AcquireBomb(BombData.Location, BombData.Rotation, Params);
             if (Bomb)
             {
                 Bomb->Initialize(&BombData, ParentWeapon);
@@ -461,6 +582,8 @@ void UFlareSector::UnregisterShell(AFlareShell* Shell)
 
 void UFlareSector::SetPause(bool Pause)
 {
+	IsSectorPaused = Pause;
+
 	for (int i = 0 ; i < SectorSpacecrafts.Num(); i++)
 	{
 		SectorSpacecrafts[i]->SetPause(Pause);
@@ -539,47 +662,87 @@ AActor* UFlareSector::GetNearestBody(FVector Location, float* NearestDistance, b
 	return NearestCandidateActor;
 }
 
+const FFlareSectorBroadphase& UFlareSector::GetBroadphase()
+{
+	if (!SectorBroadphaseCache || SectorBroadphaseFrame != GFrameCounter)
+	{
+		UpdateBroadphase();
+	}
+
+	return SectorBroadphase;
+}
+
+void UFlareSector::UpdateBroadphase()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateBroadphase);
+
+	SectorBroadphaseCache = true;
+	SectorBroadphaseFrame = GFrameCounter;
+	SectorBroadphase.Reset();
+
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		SectorBroadphase.Add(Spacecraft, Spacecraft->GetActorLocation(), Spacecraft->Airframe->GetPhysicsLinearVelocity(),
+			Spacecraft->GetMeshScale(), EFlareBroadphaseType::Spacecraft);
+	}
+
+	for (AFlareAsteroid* Asteroid : SectorAsteroids)
+	{
+		SectorBroadphase.Add(Asteroid, Asteroid->GetActorLocation(), Asteroid->GetAsteroidComponent()->GetPhysicsLinearVelocity(),
+			Asteroid->GetAsteroidComponent()->Bounds.SphereRadius, EFlareBroadphaseType::Asteroid);
+	}
+
+	for (AFlareMeteorite* Meteorite : SectorMeteorites)
+	{
+		SectorBroadphase.Add(Meteorite, Meteorite->GetActorLocation(), Meteorite->GetMeteoriteComponent()->GetPhysicsLinearVelocity(),
+			Meteorite->GetMeteoriteComponent()->Bounds.SphereRadius, EFlareBroadphaseType::Meteorite);
+	}
+
+	// Colliders are level actors, they come with the sector level
+	for (TActorIterator<AFlareCollider> ColliderIterator(GetGame()->GetWorld()); ColliderIterator; ++ColliderIterator)
+	{
+		AFlareCollider* Collider = *ColliderIterator;
+		UStaticMeshComponent* ColliderComponent = Cast<UStaticMeshComponent>(Collider->GetRootComponent());
+		if (!ColliderComponent)
+		{
+			continue;
+		}
+
+		SectorBroadphase.Add(Collider, Collider->GetActorLocation(), FVector::ZeroVector,
+			ColliderComponent->Bounds.SphereRadius, EFlareBroadphaseType::Collider);
+	}
+}
+
 void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location)
 {
 	float RandomLocationRadiusIncrement = 100000; // 1000m
 	float RandomLocationRadius = RandomLocationRadiusIncrement;
-	float EffectiveDistance = -1;
+	float Size = (Spacecraft->IsStation() ? 80000 : Spacecraft->GetMeshScale());
+
+	const FFlareSectorBroadphase& Broadphase = GetBroadphase();
+	TArray<int32> Overlaps;
 
 	do 
 	{
 		Location += FMath::VRand() * RandomLocationRadius;
-		float Size = (Spacecraft->IsStation() ? 80000 : Spacecraft->GetMeshScale());
-		float NearestDistance;
 
 		// Check if location is secure
-		if (GetNearestBody(Location, &NearestDistance, true, Spacecraft) == NULL)
+		Broadphase.QueryRadius(Location, Size, EFlareBroadphaseType::All, Overlaps);
+		if (Overlaps.Num() == 0)
 		{
-			// No other ship.
 			break;
 		}
 
-		EffectiveDistance = NearestDistance - Size;
 		RandomLocationRadius += RandomLocationRadiusIncrement;
 	}
-	while (EffectiveDistance <= 0 && RandomLocationRadius < RandomLocationRadiusIncrement * 1000);
+	while (RandomLocationRadius < RandomLocationRadiusIncrement * 1000);
 
 #if !UE_BUILD_SHIPPING
+	Broadphase.QueryRadius(Location, Spacecraft->GetSimpleCollisionRadius(), EFlareBroadphaseType::Collider, Overlaps);
+	for (int32 Index : Overlaps)
 	{
-		TArray<AActor*> ColliderActorList;
-		UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-		for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
-		{
-			AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
-
-			float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
-			float SpacecraftSize = Spacecraft->GetSimpleCollisionRadius();
-			float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location);
-			
-			if (Distance < CandidateSize + SpacecraftSize)
-			{
-				FLOGV("UFlareSector::PlaceSpacecraft : %s was placed inside collider '%s'", *Spacecraft->GetImmatriculation().ToString(), *ColliderCandidate->GetName());
-			}
-		}
+		FLOGV("UFlareSector::PlaceSpacecraft : %s was placed inside collider '%s'",
+			*Spacecraft->GetImmatriculation().ToString(), *Broadphase.GetEntry(Index).Actor->GetName());
 	}
 #endif
 
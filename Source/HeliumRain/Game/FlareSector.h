@@ -6,6 +6,7 @@
 #include "FlareAsteroid.h"
 #include "../Quests/FlareMeteorite.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSectorBroadphase.h"
 #include "FlareSector.generated.h"
 
 class UFlareSimulatedSector;
@@ -23,9 +24,12 @@ public:
 	  Save
 	----------------------------------------------------*/
 
-	/** Load the sector from a save file */
+	/** Load the sector from a save file. Stations and player spacecrafts are loaded now, other spacecrafts by ContinueLoading */
 	virtual void Load(UFlareSimulatedSector* Parent);
 
+	/** Spawn pending spacecrafts within the frame budget, then bombs. Return true once the sector is fully loaded. */
+	bool ContinueLoading();
+
 	/** Save the sector to a save file */
 	virtual void Save();
 
@@ -59,8 +63,14 @@ public:
 
 	void PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location);
 
+	/** Get the spatial index of spacecrafts, asteroids, meteorites and colliders, rebuilt once per frame */
+	const FFlareSectorBroadphase& GetBroadphase();
+
 protected:
 
+	/** Rebuild the spatial index from the current positions */
+	void UpdateBroadphase();
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -89,7 +99,18 @@ protected:
 
 	int64						   LocalTime;
 	bool						   SectorRepartitionCache;
+	bool                           SectorBroadphaseCache;
+	uint64                         SectorBroadphaseFrame;
+	FFlareSectorBroadphase         SectorBroadphase;
 	bool                           IsDestroyingSector;
+	bool                           IsSectorLoading;
+	bool                           IsSectorPaused;
+
+	// Spacecrafts waiting to be spawned by ContinueLoading
+	UPROPERTY()
+	TArray<UFlareSimulatedSpacecraft*> PendingSpacecrafts;
+	int32                          PendingSpacecraftIndex;
+
 	FVector                        SectorCenter;
 	float                          SectorRadius;
 
@@ -166,6 +187,18 @@ public:
 		return LocalTime;
 	}
 
+	/** Check if spacecrafts or bombs are still waiting to be spawned */
+	inline bool IsLoading() const
+	{
+		return IsSectorLoading;
+	}
+
+	/** Get the ratio of pending spacecrafts already spawned */
+	inline float GetLoadingProgress() const
+	{
+		return (IsSectorLoading && PendingSpacecrafts.Num() > 0) ? (float)PendingSpacecraftIndex / (float)PendingSpacecrafts.Num() : 1.0f;
+	}
+
 	void GenerateSectorRepartitionCache();
 
 	FVector GetSectorCenter();
@@ -0,0 +1,143 @@
+
+#include "FlareSectorBroadphase.h"
+#include "../Flare.h"
+
+
+// Cell size in cm
+#define BROADPHASE_CELL_SIZE 50000
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSectorBroadphase::FFlareSectorBroadphase()
+	: CellSize(BROADPHASE_CELL_SIZE)
+	, MaxSpeed(0)
+{
+}
+
+
+/*----------------------------------------------------
+	Content
+----------------------------------------------------*/
+
+void FFlareSectorBroadphase::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	LargeEntries.Reset();
+	MaxSpeed = 0;
+}
+
+void FFlareSectorBroadphase::Add(AActor* Actor, FVector Location, FVector Velocity, float Radius, EFlareBroadphaseType::Type Type)
+{
+	FFlareBroadphaseEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Location = Location;
+	Entry.Velocity = Velocity;
+	Entry.Radius = Radius;
+	Entry.Type = Type;
+
+	int32 Index = Entries.Add(Entry);
+	MaxSpeed = FMath::Max(MaxSpeed, Velocity.Size());
+
+	if (Radius > CellSize)
+	{
+		LargeEntries.Add(Index);
+	}
+	else
+	{
+		Cells.FindOrAdd(GetCell(Location)).Add(Index);
+	}
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+void FFlareSectorBroadphase::QueryRadius(FVector Location, float Radius, int32 TypeMask, TArray<int32>& Results) const
+{
+	FVector Extent = FVector(Radius, Radius, Radius);
+
+	QueryBox(Location - Extent, Location + Extent, TypeMask, Results, [&](const FFlareBroadphaseEntry& Entry)
+	{
+		return FVector::DistSquared(Entry.Location, Location) <= FMath::Square(Radius + Entry.Radius);
+	});
+}
+
+void FFlareSectorBroadphase::QuerySweptSphere(FVector Start, FVector End, float Radius, int32 TypeMask, TArray<int32>& Results) const
+{
+	FVector Extent = FVector(Radius, Radius, Radius);
+
+	QueryBox(Start.ComponentMin(End) - Extent, Start.ComponentMax(End) + Extent, TypeMask, Results, [&](const FFlareBroadphaseEntry& Entry)
+	{
+		return FMath::PointDistToSegmentSquared(Entry.Location, Start, End) <= FMath::Square(Radius + Entry.Radius);
+	});
+}
+
+template <typename FilterType>
+void FFlareSectorBroadphase::QueryBox(FVector Min, FVector Max, int32 TypeMask, TArray<int32>& Results, FilterType Filter) const
+{
+	Results.Reset();
+
+	auto TestEntry = [&](int32 Index)
+	{
+		const FFlareBroadphaseEntry& Entry = Entries[Index];
+		if ((Entry.Type & TypeMask) && Filter(Entry))
+		{
+			Results.Add(Index);
+		}
+	};
+
+	// Small objects may overlap the neighbour cells
+	FIntVector MinCell = GetCell(Min - FVector(CellSize, CellSize, CellSize));
+	FIntVector MaxCell = GetCell(Max + FVector(CellSize, CellSize, CellSize));
+	int64 CellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+	if (CellCount > Cells.Num())
+	{
+		// Walking the box would cost more than walking the used cells
+		for (auto& Cell : Cells)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X
+			 && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y
+			 && Cell.Key.Z >= MinCell.Z && Cell.Key.Z <= MaxCell.Z)
+			{
+				for (int32 Index : Cell.Value)
+				{
+					TestEntry(Index);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+					if (Cell)
+					{
+						for (int32 Index : *Cell)
+						{
+							TestEntry(Index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (int32 Index : LargeEntries)
+	{
+		TestEntry(Index);
+	}
+
+	// Keep the order of the sector lists, so that results don't depend on the grid layout
+	Results.Sort();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Object.h"
+
+
+/** Kind of object stored in the broadphase, used as query filter */
+namespace EFlareBroadphaseType
+{
+	enum Type
+	{
+		Spacecraft = 1,
+		Asteroid = 2,
+		Meteorite = 4,
+		Collider = 8,
+
+		All = Spacecraft | Asteroid | Meteorite | Collider
+	};
+}
+
+/** Object stored in the broadphase */
+struct FFlareBroadphaseEntry
+{
+	AActor*                          Actor;
+	FVector                          Location;
+	FVector                          Velocity;
+	float                            Radius;
+	EFlareBroadphaseType::Type       Type;
+};
+
+/** Uniform grid over the objects of the active sector, used to skip distant objects in proximity queries */
+struct FFlareSectorBroadphase
+{
+public:
+
+	FFlareSectorBroadphase();
+
+	/** Remove all objects */
+	void Reset();
+
+	/** Add an object. Location and radius describe its bounding sphere, velocity is in cm/s */
+	void Add(AActor* Actor, FVector Location, FVector Velocity, float Radius, EFlareBroadphaseType::Type Type);
+
+	/** Find the objects whose bounding sphere intersects a sphere */
+	void QueryRadius(FVector Location, float Radius, int32 TypeMask, TArray<int32>& Results) const;
+
+	/** Find the objects whose bounding sphere intersects a sphere moving from Start to End */
+	void QuerySweptSphere(FVector Start, FVector End, float Radius, int32 TypeMask, TArray<int32>& Results) const;
+
+	/** Find the objects whose bounding sphere intersects a segment */
+	void QueryRay(FVector Start, FVector End, int32 TypeMask, TArray<int32>& Results) const
+	{
+		QuerySweptSphere(Start, End, 0, TypeMask, Results);
+	}
+
+	/** Get an object from its query result index */
+	inline const FFlareBroadphaseEntry& GetEntry(int32 Index) const
+	{
+		return Entries[Index];
+	}
+
+	/** Get the highest object speed, in cm/s */
+	inline float GetMaxSpeed() const
+	{
+		return MaxSpeed;
+	}
+
+	inline int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+
+protected:
+
+	/** Get the cell containing a location */
+	inline FIntVector GetCell(FVector Location) const
+	{
+		return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+	}
+
+	/** Add the objects of the cells overlapping a box that pass the filter. Results are sorted in insertion order */
+	template <typename FilterType>
+	void QueryBox(FVector Min, FVector Max, int32 TypeMask, TArray<int32>& Results, FilterType Filter) const;
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FFlareBroadphaseEntry>    Entries;
+
+	// Objects smaller than a cell are stored in the cell of their center, larger ones are always tested
+	TMap<FIntVector, TArray<int32>>  Cells;
+	TArray<int32>                    LargeEntries;
+
+	float                            CellSize;
+	float                            MaxSpeed;
+
+};
@@ -254,6 +254,8 @@ int32 SectorHelper::Trade(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSim
 	// Set the trading state if not player fleet
 	if (GivenResources > 0)
 	{
+		SourceSpacecraft->GetGame()->GetGameWorld()->GetResourceStatsCache().Invalidate(SourceSpacecraft->GetCurrentSector());
+
 		AFlarePlayerController* PC = SourceSpacecraft->GetGame()->GetPC();
 		UFlareFleet* PlayerFleet = PC->GetPlayerFleet();
 		FCHECK(PC);
@@ -780,57 +782,159 @@ int32 SectorHelper::GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UF
 }
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector)
+void FFlareResourceLedgerTraders::Add(EFlareResourceRestriction::Type Restriction, UFlareCompany* Owner)
 {
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	switch (Restriction)
+	{
+		case EFlareResourceRestriction::Everybody:
+			Everybody = true;
+			break;
+		case EFlareResourceRestriction::OwnerOnly:
+			Owners.AddUnique(Owner);
+			break;
+		case EFlareResourceRestriction::Nobody:
+			Nobody = true;
+			break;
+	}
+}
 
-	// Init
-	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+bool FFlareResourceLedgerTraders::Accepts(UFlareCompany* Client) const
+{
+	if (Client)
+	{
+		return Everybody || Owners.Contains(Client);
+	}
+	else
 	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats ResourceStats;
-		ResourceStats.Production = 0;
-		ResourceStats.Consumption = 0;
-		ResourceStats.Balance = 0;
-		ResourceStats.Stock = 0;
-		ResourceStats.Capacity = 0;
+		return Everybody || Nobody || Owners.Num() > 0;
+	}
+}
 
-		WorldStats.Add(Resource, ResourceStats);
+TArray<WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector)
+{
+	FFlareSectorResourceLedger Ledger;
+	ComputeResourceLedger(Sector, Ledger);
+
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+	WorldStats.Reserve(Ledger.Resources.Num());
+	for (const FFlareResourceLedgerEntry& Entry : Ledger.Resources)
+	{
+		WorldStats.Add(Entry.Stats);
 	}
 
-	for (int SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
+	// FS
+	FFlareResourceDescription* FleetSupply = Sector->GetGame()->GetScenarioTools()->FleetSupply;
+	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply->Index];
+	FFlareFloatBuffer* Stats = &Sector->GetData()->FleetSupplyConsumptionStats;
+	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
+	FSResourceStats->Consumption += MeanConsumption;
+	FSResourceStats->Capacity += Stats->GetValue(0);
+
+
+	// Customer flow
+	for (int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
+		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
+		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->Index];
+
+		ResourceStats->Consumption += Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+	}
+
+	// Balance
+	for (WorldHelper::FlareResourceStats& ResourceStats : WorldStats)
+	{
+		ResourceStats.Balance = ResourceStats.Production - ResourceStats.Consumption;
+	}
+
+	return WorldStats;
+
+}
+
+void SectorHelper::ComputeResourceLedger(UFlareSimulatedSector* Sector, FFlareSectorResourceLedger& Ledger)
+{
+	UFlareResourceCatalog* ResourceCatalog = Sector->GetGame()->GetResourceCatalog();
+	int32 ResourceCount = ResourceCatalog->Resources.Num();
 
-		// Stock
-		TArray<FFlareCargo>& CargoBaySlots = Spacecraft->GetCargoBay()->GetSlots();
-		for (int CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
+	// Init
+	Ledger.Resources.SetNum(ResourceCount);
+	Ledger.FreeSlotBuyers = FFlareResourceLedgerTraders();
+	for (FFlareResourceLedgerEntry& Entry : Ledger.Resources)
+	{
+		Entry.WantedPriceSum = 0;
+		Entry.WantedWeightSum = 0;
+		Entry.Stats.Production = 0;
+		Entry.Stats.Consumption = 0;
+		Entry.Stats.Balance = 0;
+		Entry.Stats.Stock = 0;
+		Entry.Stats.Capacity = 0;
+		Entry.Buyers = FFlareResourceLedgerTraders();
+		Entry.Sellers = FFlareResourceLedgerTraders();
+	}
+
+	TArray<int32> StationStock;
+	StationStock.SetNumZeroed(ResourceCount);
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : Sector->GetSectorSpacecrafts())
+	{
+		UFlareCargoBay* CargoBay = Spacecraft->GetCargoBay();
+		int32 SlotCapacity = CargoBay->GetSlotCapacity();
+		bool IsStation = Spacecraft->IsStation();
+
+		// Stock and trade slots
+		FMemory::Memzero(StationStock.GetData(), ResourceCount * sizeof(int32));
+		for (const FFlareCargo& Cargo : CargoBay->GetSlots())
 		{
-			FFlareCargo& Cargo = CargoBaySlots[CargoIndex];
+			if (IsStation)
+			{
+				bool CanBuy = (Cargo.Lock == EFlareResourceLock::NoLock || Cargo.Lock == EFlareResourceLock::Input || Cargo.Lock == EFlareResourceLock::Trade);
+				bool CanSell = (Cargo.Lock == EFlareResourceLock::NoLock || Cargo.Lock == EFlareResourceLock::Output || Cargo.Lock == EFlareResourceLock::Trade);
+
+				if (!Cargo.Resource)
+				{
+					if (CanBuy)
+					{
+						Ledger.FreeSlotBuyers.Add(Cargo.Restriction, Spacecraft->GetCompany());
+					}
+				}
+				else
+				{
+					if (CanBuy)
+					{
+						Ledger.Resources[Cargo.Resource->Index].Buyers.Add(Cargo.Restriction, Spacecraft->GetCompany());
+					}
+
+					if (CanSell && Cargo.Quantity > 0)
+					{
+						Ledger.Resources[Cargo.Resource->Index].Sellers.Add(Cargo.Restriction, Spacecraft->GetCompany());
+					}
+				}
+			}
 
 			if (!Cargo.Resource)
 			{
 				continue;
 			}
 
-			WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Cargo.Resource];
+			StationStock[Cargo.Resource->Index] += Cargo.Quantity;
+			WorldHelper::FlareResourceStats *ResourceStats = &Ledger.Resources[Cargo.Resource->Index].Stats;
 
 			switch (Spacecraft->GetResourceUseType(Cargo.Resource))
 			{
 				case EFlareResourcePriceContext::FactoryInput:
 				case EFlareResourcePriceContext::ConsumerConsumption:
-					ResourceStats->Capacity += Spacecraft->GetCargoBay()->GetSlotCapacity() - Cargo.Quantity;
+					ResourceStats->Capacity += SlotCapacity - Cargo.Quantity;
 				break;
 				case EFlareResourcePriceContext::FactoryOutput:
 					ResourceStats->Stock += Cargo.Quantity;
 				break;
 				case EFlareResourcePriceContext::MaintenanceConsumption:
-					ResourceStats->Capacity += Spacecraft->GetCargoBay()->GetSlotCapacity() - Cargo.Quantity;
+					ResourceStats->Capacity += SlotCapacity - Cargo.Quantity;
 					ResourceStats->Stock += Cargo.Quantity;
 				break;
 			}
 		}
 
+		// Production flows
 		for (int32 FactoryIndex = 0; FactoryIndex < Spacecraft->GetFactories().Num(); FactoryIndex++)
 		{
 			UFlareFactory* Factory = Spacecraft->GetFactories()[FactoryIndex];
@@ -844,7 +948,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 					for(const FFlareFactoryResource& FactoryResource : ProductionData->InputResources)
 					{
 						const FFlareResourceDescription* Resource = &FactoryResource.Resource->Data;
-						WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+						WorldHelper::FlareResourceStats *ResourceStats = &Ledger.Resources[Resource->Index].Stats;
 
 						int64 ProductionDuration = ProductionData->ProductionTime;
 
@@ -876,7 +980,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &Ledger.Resources[Resource->Index].Stats;
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 
@@ -898,7 +1002,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &Ledger.Resources[Resource->Index].Stats;
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -910,42 +1014,68 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 				ResourceStats->Production+= Flow;
 			}
 		}
-	}
 
-	// FS
-	FFlareResourceDescription* FleetSupply = Sector->GetGame()->GetScenarioTools()->FleetSupply;
-	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply];
-	FFlareFloatBuffer* Stats = &Sector->GetData()->FleetSupplyConsumptionStats;
-	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
-	FSResourceStats->Consumption += MeanConsumption;
-	FSResourceStats->Capacity += Stats->GetValue(0);
+		// Price pressure : stations with slot restrictions don't impact the price
+		if (!IsStation || CargoBay->HasRestrictions())
+		{
+			continue;
+		}
 
+		auto AddPricePressure = [&](const FFlareResourceDescription* Resource, float Weight)
+		{
+			FFlareResourceLedgerEntry& Entry = Ledger.Resources[Resource->Index];
+			float StockRatio = FMath::Clamp((float) StationStock[Resource->Index] / (float) SlotCapacity, 0.f, 1.f);
+			Entry.WantedPriceSum += Weight * (1.f - StockRatio);
+			Entry.WantedWeightSum += Weight;
+		};
+
+		// A resource counts once per factory side, with its first quantity
+		auto AddFactoryPricePressure = [&](const TArray<FFlareFactoryResource>& FactoryResources)
+		{
+			for (int32 ResourceIndex = 0; ResourceIndex < FactoryResources.Num(); ResourceIndex++)
+			{
+				const UFlareResourceCatalogEntry* Resource = FactoryResources[ResourceIndex].Resource;
+				bool FirstOccurrence = true;
 
-	// Customer flow
-	for (int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
-	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				for (int32 PreviousIndex = 0; PreviousIndex < ResourceIndex; PreviousIndex++)
+				{
+					if (FactoryResources[PreviousIndex].Resource == Resource)
+					{
+						FirstOccurrence = false;
+						break;
+					}
+				}
 
-		ResourceStats->Consumption += Sector->GetPeople()->GetRessourceConsumption(Resource, false);
-	}
+				if (FirstOccurrence)
+				{
+					AddPricePressure(&Resource->Data, FactoryResources[ResourceIndex].Quantity);
+				}
+			}
+		};
 
-	// Balance
-	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
-	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		for (UFlareFactory* Factory : Spacecraft->GetFactories())
+		{
+			if (Factory->IsActive())
+			{
+				AddFactoryPricePressure(Factory->GetCycleData().InputResources);
+				AddFactoryPricePressure(Factory->GetCycleData().OutputResources);
+			}
+		}
 
-		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
+		if (Spacecraft->HasCapability(EFlareSpacecraftCapability::Consumer))
+		{
+			for (UFlareResourceCatalogEntry* Resource : ResourceCatalog->ConsumerResources)
+			{
+				AddPricePressure(&Resource->Data, Sector->GetPeople()->GetRessourceConsumption(&Resource->Data, false));
+			}
+		}
 
-		/*FLOGV("World stats for %s: Production=%f Consumption=%f Balance=%f Stock=%d",
-			  *Resource->Name.ToString(),
-			  ResourceStats->Production,
-			  ResourceStats->Consumption,
-			  ResourceStats->Balance,
-			  ResourceStats->Stock);*/
+		if (Spacecraft->HasCapability(EFlareSpacecraftCapability::Maintenance))
+		{
+			for (UFlareResourceCatalogEntry* Resource : ResourceCatalog->MaintenanceResources)
+			{
+				AddPricePressure(&Resource->Data, 1.f);
+			}
+		}
 	}
-
-	return WorldStats;
-
 }
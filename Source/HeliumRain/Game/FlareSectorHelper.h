@@ -5,6 +5,67 @@
 #include "../Game/FlareTradeRoute.h"
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
 
+
+/** Companies allowed to trade a resource with some station slots */
+struct FFlareResourceLedgerTraders
+{
+	/** Some slots are open to everybody */
+	bool Everybody;
+
+	/** Some slots are closed to every client */
+	bool Nobody;
+
+	/** Owners of the slots open to their owner only */
+	TArray<UFlareCompany*, TInlineAllocator<4>> Owners;
+
+	FFlareResourceLedgerTraders()
+		: Everybody(false)
+		, Nobody(false)
+	{}
+
+	void Add(EFlareResourceRestriction::Type Restriction, UFlareCompany* Owner);
+
+	/** Check if a client can trade with one of the slots, any slot if no client */
+	bool Accepts(UFlareCompany* Client) const;
+};
+
+/** Aggregated station data for one resource in a sector */
+struct FFlareResourceLedgerEntry
+{
+	/** Price pressure from station stocks, weighted by station needs */
+	float WantedPriceSum;
+	float WantedWeightSum;
+
+	/** Resource stats */
+	WorldHelper::FlareResourceStats Stats;
+
+	/** Station slots that can buy or sell this resource */
+	FFlareResourceLedgerTraders Buyers;
+	FFlareResourceLedgerTraders Sellers;
+};
+
+/** Resource data for all stations of a sector, built in one pass, indexed by resource */
+struct FFlareSectorResourceLedger
+{
+	TArray<FFlareResourceLedgerEntry> Resources;
+
+	/** Empty station slots, that can buy any resource */
+	FFlareResourceLedgerTraders FreeSlotBuyers;
+
+	/** Can a station of this sector unload or sell this resource ? */
+	bool WantBuy(const FFlareResourceDescription* Resource, UFlareCompany* Client) const
+	{
+		return Resources[Resource->Index].Buyers.Accepts(Client) || FreeSlotBuyers.Accepts(Client);
+	}
+
+	/** Can a station of this sector load or buy this resource ? */
+	bool WantSell(const FFlareResourceDescription* Resource, UFlareCompany* Client) const
+	{
+		return Resources[Resource->Index].Sellers.Accepts(Client);
+	}
+};
+
+
 struct SectorHelper
 {
 	struct FlareTradeRequest
@@ -49,6 +110,9 @@ struct SectorHelper
 
 	static int32 GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UFlareCompany* Company, bool ReduceByDamage);
 
-	static TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector);
+	static TArray<WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector);
+
+	/** Aggregate the stocks, flows and trade slots of all resources in one pass over the sector spacecrafts */
+	static void ComputeResourceLedger(UFlareSimulatedSector* Sector, FFlareSectorResourceLedger& Ledger);
 
 };
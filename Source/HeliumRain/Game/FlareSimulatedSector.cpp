@@ -6,6 +6,7 @@
 #include "FlareGame.h"
 #include "FlareGameTools.h"
 #include "FlareGameUserSettings.h"
+#include "FlareSectorHelper.h"
 #include <random>
 
 #include "../Data/FlareResourceCatalog.h"
@@ -40,6 +41,8 @@ UFlareSimulatedSector::UFlareSimulatedSector(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 	PersistentStationIndex = 0;
+	WorldIndex = INDEX_NONE;
+	SaveDirty = true;
 }
 
 void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, const FFlareSectorSave& Data, const FFlareSectorOrbitParameters& OrbitParameters)
@@ -56,6 +59,7 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 
 
 	SectorData = Data;
+	SaveDirty = true;
 	SectorDescription = Description;
 	SectorOrbitParameters = OrbitParameters;
 	SectorShips.Empty();
@@ -151,14 +155,25 @@ FFlareSectorSave* UFlareSimulatedSector::Save()
 
 	SaveResourcePrices();
 
-	if(Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this)
+	if(IsActive())
 	{
 		Game->GetActiveSector()->Save();
 	}
 
+	SaveDirty = false;
 	return &SectorData;
 }
 
+bool UFlareSimulatedSector::IsSaveDirty() const
+{
+	return SaveDirty || IsActive();
+}
+
+bool UFlareSimulatedSector::IsActive() const
+{
+	return Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this;
+}
+
 
 UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateStation(FName StationClass, UFlareCompany* Company, bool UnderConstruction, FFlareStationSpawnParameters SpawnParameters)
 {
@@ -388,6 +403,8 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 	SectorSpacecrafts.Add(Spacecraft);
 
 	Spacecraft->SetCurrentSector(this);
+	MarkSaveDirty();
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(this);
 
 	FLOGV("UFlareSimulatedSector::CreateShip : Created ship '%s' at %s", *Spacecraft->GetImmatriculation().ToString(), *TargetPosition.ToString());
 
@@ -411,6 +428,8 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 
 void UFlareSimulatedSector::CreateAsteroid(int32 ID, FName Name, FVector Location)
 {
+	MarkSaveDirty();
+
 	// Compute size
 	float MinSize = 0.5;
 	float MinMaxSize = 0.75;
@@ -433,6 +452,8 @@ void UFlareSimulatedSector::CreateAsteroid(int32 ID, FName Name, FVector Locatio
 
 void UFlareSimulatedSector::AddFleet(UFlareFleet* Fleet)
 {
+	MarkSaveDirty();
+
 	SectorFleets.AddUnique(Fleet);
 
 	for (int ShipIndex = 0; ShipIndex < Fleet->GetShips().Num(); ShipIndex++)
@@ -450,6 +471,8 @@ void UFlareSimulatedSector::DisbandFleet(UFlareFleet* Fleet)
         FLOGV("UFlareSimulatedSector::DisbandFleet : Disband fail. Fleet '%s' is not in sector '%s'", *Fleet->GetFleetName().ToString(), *GetSectorName().ToString())
 		return;
 	}
+
+	MarkSaveDirty();
 }
 
 void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
@@ -461,6 +484,8 @@ void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
 		return;
 	}
 
+	MarkSaveDirty();
+
 	for (int ShipIndex = 0; ShipIndex < Fleet->GetShips().Num(); ShipIndex++)
 	{
 		UFlareSimulatedSpacecraft* Spacecraft = Fleet->GetShips()[ShipIndex];
@@ -475,6 +500,9 @@ void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
 
 int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
+	MarkSaveDirty();
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(this);
+
 	SectorStations.Remove(Spacecraft);
 	SectorShips.Remove(Spacecraft);
 	return SectorSpacecrafts.Remove(Spacecraft);
@@ -484,6 +512,12 @@ int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraf
 void UFlareSimulatedSector::SetSectorOrbitParameters(const FFlareSectorOrbitParameters& OrbitParameters)
 {
 	SectorOrbitParameters = OrbitParameters;
+
+	// World sectors share a precomputed travel matrix
+	if (WorldIndex != INDEX_NONE)
+	{
+		Game->GetGameWorld()->InvalidateTravelDurations();
+	}
 }
 
 /*----------------------------------------------------
@@ -672,6 +706,7 @@ bool UFlareSimulatedSector::UpgradeStation(UFlareSimulatedSpacecraft* Station)
 	GetPeople()->Pay(ProductionCost);
 
 	Station->Upgrade();
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(this);
 
 	return true;
 }
@@ -700,6 +735,7 @@ void UFlareSimulatedSector::AttachStationToAsteroid(UFlareSimulatedSpacecraft* S
 		FLOGV("UFlareSimulatedSector::AttachStationToAsteroid : Found asteroid we need to attach to ('%s')", *AsteroidSave->Identifier.ToString());
 		Spacecraft->SetAsteroidData(AsteroidSave);
 		SectorData.AsteroidData.RemoveAt(AsteroidSaveIndex);
+		MarkSaveDirty();
 	}
 	else
 	{
@@ -714,17 +750,20 @@ void UFlareSimulatedSector::AttachStationToActor(UFlareSimulatedSpacecraft* Spac
 
 void UFlareSimulatedSector::SimulatePriceVariation()
 {
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_SimulatePriceVariation);
+
+	FFlareSectorResourceLedger Ledger;
+	SectorHelper::ComputeResourceLedger(this, Ledger);
+
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		SimulatePriceVariation(Resource);
+		SimulatePriceVariation(Resource, Ledger.Resources[Resource->Index]);
 	}
 }
 
-void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Resource)
+void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Resource, const FFlareResourceLedgerEntry& Ledger)
 {
-	SCOPE_CYCLE_COUNTER(STAT_FlareSector_SimulatePriceVariation);
-
 	float OldPrice = GetPreciseResourcePrice(Resource);
 	// Prices can increase because :
 
@@ -738,62 +777,9 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 	//  - Consumer ressource is full (and more than half)
 	//  - Maintenance ressource is full (and more than half) (very slow decrease)
 
-
-	float WantedPriceSum = 0;
-	float WantedWeightSum = 0;
-
-
-	// Prices never go below min production cost
-	for (int32 CountIndex = 0 ; CountIndex < SectorStations.Num(); CountIndex++)
-	{
-		UFlareSimulatedSpacecraft* Station = SectorStations[CountIndex];
-
-		if(Station->GetCargoBay()->HasRestrictions())
-		{
-			// Not allow station with slot restriction to impact the price
-			continue;
-		}
-
-		float StockRatio = FMath::Clamp((float) Station->GetCargoBay()->GetResourceQuantity(Resource, NULL) / (float) Station->GetCargoBay()->GetSlotCapacity(), 0.f, 1.f);
-
-		for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
-		{
-			UFlareFactory* Factory = Station->GetFactories()[FactoryIndex];
-
-			if(!Factory->IsActive())
-			{
-				continue;
-			}
-
-
-			if (Factory->HasInputResource(Resource))
-			{
-				float Weight = Factory->GetInputResourceQuantity(Resource);
-				WantedPriceSum += Weight * (1.f - StockRatio);
-				WantedWeightSum += Weight;
-			}
-
-			if (Factory->HasOutputResource(Resource))
-			{
-				float Weight = Factory->GetOutputResourceQuantity(Resource);
-				WantedPriceSum += Weight * (1.f - StockRatio);
-				WantedWeightSum += Weight;
-			}
-		}
-
-		if(Station->HasCapability(EFlareSpacecraftCapability::Consumer) && Resource->IsConsumerResource)
-		{
-			float Weight = GetPeople()->GetRessourceConsumption(Resource, false);
-			WantedPriceSum += Weight * (1.f - StockRatio);
-			WantedWeightSum += Weight;
-		}
-
-		if(Station->HasCapability(EFlareSpacecraftCapability::Maintenance) && Resource->IsMaintenanceResource)
-		{
-			WantedPriceSum += 1.f - StockRatio;
-			WantedWeightSum += 1;
-		}
-	}
+	// Station stocks are aggregated in the sector ledger
+	float WantedPriceSum = Ledger.WantedPriceSum;
+	float WantedWeightSum = Ledger.WantedWeightSum;
 
 	if(WantedWeightSum > 0)
 	{
@@ -905,32 +891,15 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 	}
 }
 
-bool UFlareSimulatedSector::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client)
+void UFlareSimulatedSector::ClearBombs()
 {
-	for (UFlareSimulatedSpacecraft* Station : GetSectorStations())
+	if (SectorData.BombData.Num() == 0)
 	{
-		if (Station->GetCargoBay()->WantSell(Resource, Client, true))
-		{
-			return true;
-		}
+		return;
 	}
-	return false;
-}
 
-bool UFlareSimulatedSector::WantBuy(FFlareResourceDescription* Resource, UFlareCompany* Client)
-{
-	for (UFlareSimulatedSpacecraft* Station : GetSectorStations())
-	{
-		if (Station->GetCargoBay()->WantBuy(Resource, Client))
-		{
-			return true;
-		}
-	}
-	return false;
-}
+	MarkSaveDirty();
 
-void UFlareSimulatedSector::ClearBombs()
-{
 	for (int i = 0 ; i < SectorData.BombData.Num(); i++)
 	{
 		CombatLog::BombDestroyed(SectorData.BombData[i].Identifier);
@@ -1431,6 +1400,8 @@ float UFlareSimulatedSector::GetPreciseResourcePrice(FFlareResourceDescription*
 
 void UFlareSimulatedSector::SwapPrices()
 {
+	MarkSaveDirty();
+
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
@@ -1448,6 +1419,8 @@ void UFlareSimulatedSector::SwapPrices()
 
 void UFlareSimulatedSector::SetPreciseResourcePrice(FFlareResourceDescription* Resource, float NewPrice)
 {
+	MarkSaveDirty();
+
 	ResourcePrices[Resource] = FMath::Clamp(NewPrice, (float) Resource->MinPrice, (float) Resource->MaxPrice);
 }
 
@@ -1519,6 +1492,13 @@ static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimul
 
 void UFlareSimulatedSector::ProcessMeteorites()
 {
+	if (SectorData.MeteoriteData.Num() == 0)
+	{
+		return;
+	}
+
+	MarkSaveDirty();
+
 	TArray<FFlareMeteoriteSave> MeteoriteToKeep;
 
 	for(FFlareMeteoriteSave& Meteorite: SectorData.MeteoriteData)
@@ -1634,7 +1614,7 @@ void UFlareSimulatedSector::GenerateMeteorites()
 
 void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio)
 {
-	std::mt19937 e2(time(0));
+	std::mt19937 e2(FMath::Rand());
 
 	// Velocity is pick with a standard deviation and a mean increasing with the powerRatio
 
@@ -1708,6 +1688,7 @@ void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* Ta
 		Data.Damage = 0;
 		Data.HasMissed = false;
 
+		MarkSaveDirty();
 		SectorData.MeteoriteData.Add(Data);
 
 		TotalEffectiveResistance += Data.BrokenDamage;
@@ -1736,12 +1717,20 @@ void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* Ta
 
 void UFlareSimulatedSector::UpdateFleetSupplyConsumptionStats()
 {
+	MarkSaveDirty();
+
 	SectorData.FleetSupplyConsumptionStats.Append(SectorData.DailyFleetSupplyConsumption);
 	SectorData.DailyFleetSupplyConsumption = 0;
 }
 
 void UFlareSimulatedSector::OnFleetSupplyConsumed(int32 Quantity)
 {
+	if (Quantity == 0)
+	{
+		return;
+	}
+
+	MarkSaveDirty();
 	SectorData.DailyFleetSupplyConsumption += Quantity;
 }
 
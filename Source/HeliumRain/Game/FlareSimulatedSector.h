@@ -15,6 +15,7 @@ class UFlareFleet;
 class AFlareGame;
 struct FFlarePlayerSave;
 struct FFlareResourceDescription;
+struct FFlareResourceLedgerEntry;
 
 /** Factory action type values */
 UENUM()
@@ -356,6 +357,18 @@ public:
 	/** Save the sector to a save file */
     virtual FFlareSectorSave* Save();
 
+	/** Flag the save data as outdated, so that the next world save rewrites it */
+	inline void MarkSaveDirty()
+	{
+		SaveDirty = true;
+	}
+
+	/** Check if the sector changed since it was last saved */
+	bool IsSaveDirty() const;
+
+	/** Check if this sector is the active sector */
+	bool IsActive() const;
+
 	void LoadResourcePrices();
 
 	void SaveResourcePrices();
@@ -409,13 +422,8 @@ public:
 
 	void SimulatePriceVariation();
 
-	void SimulatePriceVariation(FFlareResourceDescription* Resource);
-
-	/** Can we load or buy this resource in this sector ? */
-	bool WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client);
-
-	/** Can we unload or sell this resource in this sector ? */
-	bool WantBuy(FFlareResourceDescription* Resource, UFlareCompany* Client);
+	/** Update the price of a resource from the aggregated station data */
+	void SimulatePriceVariation(FFlareResourceDescription* Resource, const FFlareResourceLedgerEntry& Ledger);
 
 	void ClearBombs();
 
@@ -437,6 +445,7 @@ protected:
 
     // Gameplay data
 	FFlareSectorSave                        SectorData;
+	bool                                    SaveDirty;
     TArray<UFlareSimulatedSpacecraft*>      SectorStations;
 	TArray<UFlareSimulatedSpacecraft*>      SectorShips;
 	TArray<UFlareSimulatedSpacecraft*>      SectorSpacecrafts;
@@ -447,6 +456,7 @@ protected:
 	UFlarePeople*							People;
 
 	int32                                   PersistentStationIndex;
+	int32                                   WorldIndex;
 	float									LightRatio;
 
 	AFlareGame*                             Game;
@@ -491,6 +501,17 @@ public:
 	/** Get the description of this sector */
 	FText GetSectorDescription() const;
 
+	/** Get the index of this sector in the world sector list, INDEX_NONE for travel sectors */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
     inline TArray<UFlareSimulatedSpacecraft*>& GetSectorStations()
     {
         return SectorStations;
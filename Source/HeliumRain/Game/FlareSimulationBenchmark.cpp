@@ -0,0 +1,205 @@
+
+#include "FlareSimulationBenchmark.h"
+#include "../Flare.h"
+
+#include "FlareGame.h"
+#include "FlareWorld.h"
+
+#include "../Data/FlareCustomizationCatalog.h"
+
+#include "../Player/FlarePlayerController.h"
+
+
+#define LOCTEXT_NAMESPACE "FlareSimulationBenchmark"
+
+#define BENCHMARK_DEFAULT_DAYS 100
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+UFlareSimulationBenchmark::UFlareSimulationBenchmark(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DayCount = BENCHMARK_DEFAULT_DAYS;
+	Seed = 0;
+	ScenarioIndex = 0;
+	SaveSlot = -1;
+}
+
+
+/*----------------------------------------------------
+	Public API
+----------------------------------------------------*/
+
+bool UFlareSimulationBenchmark::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("FlareBenchmark"));
+}
+
+void UFlareSimulationBenchmark::Init()
+{
+	Game = Cast<AFlareGame>(GetOuter());
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("BenchmarkDays="), DayCount);
+	FParse::Value(CommandLine, TEXT("BenchmarkSeed="), Seed);
+	FParse::Value(CommandLine, TEXT("BenchmarkScenario="), ScenarioIndex);
+	FParse::Value(CommandLine, TEXT("BenchmarkSlot="), SaveSlot);
+
+	if (!FParse::Value(CommandLine, TEXT("BenchmarkOutput="), OutputPath))
+	{
+		OutputPath = FString::Printf(TEXT("%s/Benchmarks/Simulation-%s.json"), *FPaths::GameSavedDir(), *FDateTime::Now().ToString());
+	}
+
+	DayCount = FMath::Max(DayCount, 1);
+
+	FLOGV("UFlareSimulationBenchmark::Init : %d days, seed %d, scenario %d, slot %d, output '%s'",
+		DayCount, Seed, ScenarioIndex, SaveSlot, *OutputPath);
+}
+
+bool UFlareSimulationBenchmark::Run(AFlarePlayerController* PC)
+{
+	// Seed before the scenario generation so that the whole run is reproducible
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	if (!SetupGame(PC))
+	{
+		FLOG("UFlareSimulationBenchmark::Run : failed to setup the game");
+		return false;
+	}
+
+	UFlareWorld* World = Game->GetGameWorld();
+	Game->DeactivateSector();
+	Game->AutoSave = false;
+
+	// Simulate
+	TArray<FFlareSimulationTimings> DayTimings;
+	DayTimings.Reserve(DayCount);
+	double StartTs = FPlatformTime::Seconds();
+
+	PC->BeginDeferredNotifications();
+	for (int32 DayIndex = 0; DayIndex < DayCount; DayIndex++)
+	{
+		World->Simulate();
+		DayTimings.Add(World->GetLastSimulationTimings());
+	}
+	PC->EndDeferredNotifications();
+
+	double TotalTime = FPlatformTime::Seconds() - StartTs;
+	FLOGV("UFlareSimulationBenchmark::Run : %d days simulated in %.3fs", DayCount, TotalTime);
+
+	bool Result = WriteReport(TotalTime, DayTimings);
+
+	// Nothing from this run should ever be saved
+	Game->UnloadGame();
+
+	return Result;
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+bool UFlareSimulationBenchmark::SetupGame(AFlarePlayerController* PC)
+{
+	if (SaveSlot >= 0)
+	{
+		Game->SetCurrentSlot(SaveSlot);
+		return Game->LoadGame(PC);
+	}
+
+	// Same company setup as a new game
+	const FFlareCompanyDescription* CurrentCompanyData = PC->GetCompanyDescription();
+	FFlareCompanyDescription CompanyData;
+	CompanyData.Name = LOCTEXT("BenchmarkCompanyName", "Benchmark Company");
+	CompanyData.ShortName = FName("BMK");
+	CompanyData.Emblem = Game->GetCustomizationCatalog()->GetEmblem(0);
+	CompanyData.CustomizationBasePaintColor = CurrentCompanyData->CustomizationBasePaintColor;
+	CompanyData.CustomizationPaintColor = CurrentCompanyData->CustomizationPaintColor;
+	CompanyData.CustomizationOverlayColor = CurrentCompanyData->CustomizationOverlayColor;
+	CompanyData.CustomizationLightColor = CurrentCompanyData->CustomizationLightColor;
+	CompanyData.CustomizationPatternIndex = CurrentCompanyData->CustomizationPatternIndex;
+
+	Game->CreateGame(PC, CompanyData, ScenarioIndex, 0, false);
+	return Game->IsLoadedOrCreated();
+}
+
+bool UFlareSimulationBenchmark::WriteReport(double TotalTime, const TArray<FFlareSimulationTimings>& DayTimings)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+	// Run parameters
+	JsonObject->SetStringField("build", Game->GetBuildDate().ToString());
+	JsonObject->SetNumberField("seed", Seed);
+	JsonObject->SetNumberField("days", DayTimings.Num());
+	if (SaveSlot >= 0)
+	{
+		JsonObject->SetNumberField("slot", SaveSlot);
+	}
+	else
+	{
+		JsonObject->SetNumberField("scenario", ScenarioIndex);
+	}
+	JsonObject->SetNumberField("startDate", DayTimings.Num() ? DayTimings[0].Date : 0);
+	JsonObject->SetNumberField("totalTime", TotalTime);
+	JsonObject->SetNumberField("daysPerSecond", TotalTime > 0 ? DayTimings.Num() / TotalTime : 0);
+
+	// Phase totals
+	FFlareBenchmarkPhaseStats PhaseStats[EFlareSimulationPhase::Num];
+	FMemory::Memzero(PhaseStats);
+	TArray< TSharedPtr<FJsonValue> > DaysArray;
+
+	for (const FFlareSimulationTimings& Timings : DayTimings)
+	{
+		TSharedRef<FJsonObject> DayObject = MakeShareable(new FJsonObject());
+		DayObject->SetNumberField("date", Timings.Date);
+		DayObject->SetNumberField("total", Timings.TotalTime);
+		DayObject->SetNumberField("allocations", Timings.TotalAllocations);
+
+		for (int32 Phase = 0; Phase < EFlareSimulationPhase::Num; Phase++)
+		{
+			double PhaseTime = Timings.PhaseTimes[Phase];
+			PhaseStats[Phase].TotalTime += PhaseTime;
+			PhaseStats[Phase].MaxTime = FMath::Max(PhaseStats[Phase].MaxTime, PhaseTime);
+			PhaseStats[Phase].Allocations += Timings.PhaseAllocations[Phase];
+			DayObject->SetNumberField(FFlareSimulationProfiler::GetPhaseName((EFlareSimulationPhase::Type) Phase), PhaseTime);
+		}
+
+		DaysArray.Add(MakeShareable(new FJsonValueObject(DayObject)));
+	}
+
+	TSharedRef<FJsonObject> PhasesObject = MakeShareable(new FJsonObject());
+	for (int32 Phase = 0; Phase < EFlareSimulationPhase::Num; Phase++)
+	{
+		TSharedRef<FJsonObject> PhaseObject = MakeShareable(new FJsonObject());
+		PhaseObject->SetNumberField("total", PhaseStats[Phase].TotalTime);
+		PhaseObject->SetNumberField("average", DayTimings.Num() ? PhaseStats[Phase].TotalTime / DayTimings.Num() : 0);
+		PhaseObject->SetNumberField("max", PhaseStats[Phase].MaxTime);
+		PhaseObject->SetNumberField("allocations", PhaseStats[Phase].Allocations);
+		PhasesObject->SetObjectField(FFlareSimulationProfiler::GetPhaseName((EFlareSimulationPhase::Type) Phase), PhaseObject);
+	}
+
+	JsonObject->SetObjectField("phases", PhasesObject);
+	JsonObject->SetArrayField("dayTimings", DaysArray);
+
+	// Write
+	FString FileContents;
+	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
+
+	if (FJsonSerializer::Serialize(JsonObject, JsonWriter) && FFileHelper::SaveStringToFile(FileContents, *OutputPath))
+	{
+		FLOGV("UFlareSimulationBenchmark::WriteReport : report written to '%s'", *OutputPath);
+		return true;
+	}
+	else
+	{
+		FLOGV("UFlareSimulationBenchmark::WriteReport : failed to write '%s'", *OutputPath);
+		return false;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
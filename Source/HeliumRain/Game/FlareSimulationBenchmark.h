@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Object.h"
+#include "FlareWorld.h"
+#include "FlareSimulationBenchmark.generated.h"
+
+
+class AFlareGame;
+class AFlarePlayerController;
+
+
+/** Accumulated timings of a simulation phase over a benchmark */
+struct FFlareBenchmarkPhaseStats
+{
+	double                   TotalTime;
+	double                   MaxTime;
+	uint64                   Allocations;
+};
+
+
+/** Headless world simulation benchmark, started from the command line :
+ *  HeliumRain -nullrhi -FlareBenchmark [-BenchmarkDays=100] [-BenchmarkSeed=0] [-BenchmarkScenario=0 | -BenchmarkSlot=1] [-BenchmarkOutput=File.json]
+ */
+UCLASS()
+class HELIUMRAIN_API UFlareSimulationBenchmark : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/*----------------------------------------------------
+		Public API
+	----------------------------------------------------*/
+
+	/** Was a benchmark requested on the command line */
+	static bool IsRequested();
+
+	/** Read the benchmark parameters from the command line */
+	void Init();
+
+	/** Create or load the game, simulate the days and write the report. The game is unloaded afterwards. */
+	bool Run(AFlarePlayerController* PC);
+
+
+protected:
+
+	/*----------------------------------------------------
+		Internals
+	----------------------------------------------------*/
+
+	/** Generate the scenario, or load the save slot */
+	bool SetupGame(AFlarePlayerController* PC);
+
+	/** Write the JSON report */
+	bool WriteReport(double TotalTime, const TArray<FFlareSimulationTimings>& DayTimings);
+
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	AFlareGame*                                Game;
+
+	// Parameters
+	int32                                      DayCount;
+	int32                                      Seed;
+	int32                                      ScenarioIndex;
+	int32                                      SaveSlot;
+	FString                                    OutputPath;
+
+};
@@ -0,0 +1,269 @@
+
+#include "FlareSimulationProfiler.h"
+#include "../Flare.h"
+
+#include "FlareGame.h"
+#include "FlareWorld.h"
+#include "FlareCompany.h"
+
+
+// Number of simulated days kept by the profiler
+#define SIMULATION_PROFILER_DAYS 32
+
+
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Battles"), STAT_FlareWorld_SimulateBattles, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate AI"), STAT_FlareWorld_SimulateAI, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate NewDay"), STAT_FlareWorld_SimulateNewDay, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Factories"), STAT_FlareWorld_SimulateFactories, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate People"), STAT_FlareWorld_SimulatePeople, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate TradeRoutes"), STAT_FlareWorld_SimulateTradeRoutes, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Travels"), STAT_FlareWorld_SimulateTravels, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Reputation"), STAT_FlareWorld_SimulateReputation, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Prices"), STAT_FlareWorld_SimulatePrices, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Migration"), STAT_FlareWorld_SimulateMigration, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate EndDay"), STAT_FlareWorld_SimulateEndDay, STATGROUP_Flare);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FlareWorld Simulate allocations"), STAT_FlareWorld_SimulateAllocations, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Timings
+----------------------------------------------------*/
+
+FFlareCompanyAITimings::FFlareCompanyAITimings()
+	: Company(NAME_None)
+{
+	FMemory::Memzero(StepTimes);
+	FMemory::Memzero(StepAllocations);
+	FMemory::Memzero(StepCalls);
+}
+
+FFlareSimulationTimings::FFlareSimulationTimings()
+{
+	Reset(0);
+}
+
+void FFlareSimulationTimings::Reset(int64 NewDate)
+{
+	Date = NewDate;
+	FMemory::Memzero(PhaseTimes);
+	FMemory::Memzero(PhaseAllocations);
+	TotalTime = 0;
+	TotalAllocations = 0;
+	CompanyAI.Reset();
+}
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSimulationProfiler::FFlareSimulationProfiler()
+	: NextDayIndex(0)
+	, DayCount(0)
+	, DayRunning(false)
+	, DayStartTime(0)
+	, DayStartAllocations(0)
+	, PhaseStartTime(0)
+	, PhaseStartCycles(0)
+	, PhaseStartAllocations(0)
+{
+	Days.SetNum(SIMULATION_PROFILER_DAYS);
+}
+
+
+/*----------------------------------------------------
+	Recording
+----------------------------------------------------*/
+
+void FFlareSimulationProfiler::BeginDay(int64 Date)
+{
+	Days[NextDayIndex].Reset(Date);
+	DayRunning = true;
+
+	DayStartTime = FPlatformTime::Seconds();
+	DayStartAllocations = GetAllocationCount();
+	PhaseStartTime = DayStartTime;
+	PhaseStartCycles = FPlatformTime::Cycles();
+	PhaseStartAllocations = DayStartAllocations;
+}
+
+void FFlareSimulationProfiler::EndPhase(EFlareSimulationPhase::Type Phase)
+{
+	if (!DayRunning)
+	{
+		return;
+	}
+
+	double Now = FPlatformTime::Seconds();
+	uint32 Cycles = FPlatformTime::Cycles() - PhaseStartCycles;
+	uint32 Allocations = GetAllocationCount();
+
+	FFlareSimulationTimings& Day = Days[NextDayIndex];
+	Day.PhaseTimes[Phase] += Now - PhaseStartTime;
+	Day.PhaseAllocations[Phase] += Allocations - PhaseStartAllocations;
+
+	switch (Phase)
+	{
+		case EFlareSimulationPhase::Battles:     SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateBattles, Cycles);     break;
+		case EFlareSimulationPhase::AI:          SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateAI, Cycles);          break;
+		case EFlareSimulationPhase::NewDay:      SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateNewDay, Cycles);      break;
+		case EFlareSimulationPhase::Factories:   SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateFactories, Cycles);   break;
+		case EFlareSimulationPhase::People:      SET_CYCLE_COUNTER(STAT_FlareWorld_SimulatePeople, Cycles);      break;
+		case EFlareSimulationPhase::TradeRoutes: SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateTradeRoutes, Cycles); break;
+		case EFlareSimulationPhase::Travels:     SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateTravels, Cycles);     break;
+		case EFlareSimulationPhase::Reputation:  SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateReputation, Cycles);  break;
+		case EFlareSimulationPhase::Prices:      SET_CYCLE_COUNTER(STAT_FlareWorld_SimulatePrices, Cycles);      break;
+		case EFlareSimulationPhase::Migration:   SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateMigration, Cycles);   break;
+		case EFlareSimulationPhase::EndDay:      SET_CYCLE_COUNTER(STAT_FlareWorld_SimulateEndDay, Cycles);      break;
+		default: break;
+	}
+
+	PhaseStartTime = Now;
+	PhaseStartCycles = FPlatformTime::Cycles();
+	PhaseStartAllocations = Allocations;
+}
+
+void FFlareSimulationProfiler::EndDay()
+{
+	if (!DayRunning)
+	{
+		return;
+	}
+
+	FFlareSimulationTimings& Day = Days[NextDayIndex];
+	Day.TotalTime = FPlatformTime::Seconds() - DayStartTime;
+	Day.TotalAllocations = GetAllocationCount() - DayStartAllocations;
+	INC_DWORD_STAT_BY(STAT_FlareWorld_SimulateAllocations, Day.TotalAllocations);
+
+	DayRunning = false;
+	NextDayIndex = (NextDayIndex + 1) % Days.Num();
+	DayCount = FMath::Min(DayCount + 1, Days.Num());
+}
+
+void FFlareSimulationProfiler::AddAIStep(UFlareCompany* Company, EFlareAIStep::Type Step, double Time, uint32 Allocations)
+{
+	if (!DayRunning || !IsInGameThread())
+	{
+		return;
+	}
+
+	TArray<FFlareCompanyAITimings>& CompanyAI = Days[NextDayIndex].CompanyAI;
+	FName CompanyName = Company->GetShortName();
+
+	FFlareCompanyAITimings* Timings = CompanyAI.FindByPredicate([=](const FFlareCompanyAITimings& Candidate)
+	{
+		return Candidate.Company == CompanyName;
+	});
+
+	if (!Timings)
+	{
+		Timings = &CompanyAI[CompanyAI.AddDefaulted()];
+		Timings->Company = CompanyName;
+	}
+
+	Timings->StepTimes[Step] += Time;
+	Timings->StepAllocations[Step] += Allocations;
+	Timings->StepCalls[Step]++;
+}
+
+
+/*----------------------------------------------------
+	Output
+----------------------------------------------------*/
+
+bool FFlareSimulationProfiler::SaveCSV(const FString& Path) const
+{
+	FString Contents = TEXT("date,scope,company,name,timeMs,allocations,calls\n");
+
+	for (int32 Index = 0; Index < Num(); Index++)
+	{
+		const FFlareSimulationTimings& Day = GetDay(Index);
+
+		Contents += FString::Printf(TEXT("%lld,day,,total,%.4f,%u,1\n"), Day.Date, Day.TotalTime * 1000, Day.TotalAllocations);
+
+		for (int32 Phase = 0; Phase < EFlareSimulationPhase::Num; Phase++)
+		{
+			Contents += FString::Printf(TEXT("%lld,phase,,%s,%.4f,%u,1\n"), Day.Date,
+				*GetPhaseName((EFlareSimulationPhase::Type) Phase), Day.PhaseTimes[Phase] * 1000, Day.PhaseAllocations[Phase]);
+		}
+
+		for (const FFlareCompanyAITimings& CompanyTimings : Day.CompanyAI)
+		{
+			for (int32 Step = 0; Step < EFlareAIStep::Num; Step++)
+			{
+				if (CompanyTimings.StepCalls[Step])
+				{
+					Contents += FString::Printf(TEXT("%lld,ai,%s,%s,%.4f,%u,%d\n"), Day.Date, *CompanyTimings.Company.ToString(),
+						*GetAIStepName((EFlareAIStep::Type) Step), CompanyTimings.StepTimes[Step] * 1000,
+						CompanyTimings.StepAllocations[Step], CompanyTimings.StepCalls[Step]);
+				}
+			}
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(Contents, *Path);
+}
+
+FString FFlareSimulationProfiler::GetPhaseName(EFlareSimulationPhase::Type Phase)
+{
+	switch (Phase)
+	{
+		case EFlareSimulationPhase::Battles:     return TEXT("battles");
+		case EFlareSimulationPhase::AI:          return TEXT("ai");
+		case EFlareSimulationPhase::NewDay:      return TEXT("newDay");
+		case EFlareSimulationPhase::Factories:   return TEXT("factories");
+		case EFlareSimulationPhase::People:      return TEXT("people");
+		case EFlareSimulationPhase::TradeRoutes: return TEXT("tradeRoutes");
+		case EFlareSimulationPhase::Travels:     return TEXT("travels");
+		case EFlareSimulationPhase::Reputation:  return TEXT("reputation");
+		case EFlareSimulationPhase::Prices:      return TEXT("prices");
+		case EFlareSimulationPhase::Migration:   return TEXT("migration");
+		case EFlareSimulationPhase::EndDay:      return TEXT("endDay");
+		default:                                 return TEXT("unknown");
+	}
+}
+
+FString FFlareSimulationProfiler::GetAIStepName(EFlareAIStep::Type Step)
+{
+	switch (Step)
+	{
+		case EFlareAIStep::UpdateTrading:            return TEXT("updateTrading");
+		case EFlareAIStep::ProcessBudget:            return TEXT("processBudget");
+		case EFlareAIStep::UpdateMilitaryMovement:   return TEXT("updateMilitaryMovement");
+		case EFlareAIStep::UpdateWarShipAcquisition: return TEXT("updateWarShipAcquisition");
+		default:                                     return TEXT("unknown");
+	}
+}
+
+uint32 FFlareSimulationProfiler::GetAllocationCount()
+{
+#if STATS
+	return FMalloc::TotalMallocCalls;
+#else
+	return 0;
+#endif
+}
+
+
+/*----------------------------------------------------
+	Scoped AI step
+----------------------------------------------------*/
+
+FFlareScopedAIStepProfile::FFlareScopedAIStepProfile(UFlareCompany* TargetCompany, EFlareAIStep::Type TargetStep)
+	: Company(TargetCompany)
+	, Step(TargetStep)
+	, StartTime(FPlatformTime::Seconds())
+	, StartAllocations(FFlareSimulationProfiler::GetAllocationCount())
+{
+}
+
+FFlareScopedAIStepProfile::~FFlareScopedAIStepProfile()
+{
+	UFlareWorld* World = Company->GetGame()->GetGameWorld();
+	if (World)
+	{
+		World->GetSimulationProfiler().AddAIStep(Company, Step,
+			FPlatformTime::Seconds() - StartTime,
+			FFlareSimulationProfiler::GetAllocationCount() - StartAllocations);
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Object.h"
+
+
+class UFlareCompany;
+
+
+/** Phases of the daily world simulation */
+namespace EFlareSimulationPhase
+{
+	enum Type
+	{
+		Battles,
+		AI,
+		NewDay,
+		Factories,
+		People,
+		TradeRoutes,
+		Travels,
+		Reputation,
+		Prices,
+		Migration,
+		EndDay,
+		Num
+	};
+}
+
+/** Profiled steps of the company AI */
+namespace EFlareAIStep
+{
+	enum Type
+	{
+		UpdateTrading,
+		ProcessBudget,
+		UpdateMilitaryMovement,
+		UpdateWarShipAcquisition,
+		Num
+	};
+}
+
+/** Time and allocations of the AI steps of a company during a simulated day */
+struct FFlareCompanyAITimings
+{
+	FFlareCompanyAITimings();
+
+	FName                    Company;
+	double                   StepTimes[EFlareAIStep::Num];
+	uint32                   StepAllocations[EFlareAIStep::Num];
+	int32                    StepCalls[EFlareAIStep::Num];
+};
+
+/** Time and allocations spent in each phase of a simulated day */
+struct FFlareSimulationTimings
+{
+	FFlareSimulationTimings();
+
+	/** Clear the timings before simulating a day */
+	void Reset(int64 NewDate);
+
+	int64                    Date;
+	double                   PhaseTimes[EFlareSimulationPhase::Num];
+	uint32                   PhaseAllocations[EFlareSimulationPhase::Num];
+	double                   TotalTime;
+	uint32                   TotalAllocations;
+
+	// AI steps, by company
+	TArray<FFlareCompanyAITimings> CompanyAI;
+};
+
+
+/** Rolling record of the last simulated days, filled by UFlareWorld::Simulate and the company AI */
+struct FFlareSimulationProfiler
+{
+public:
+
+	FFlareSimulationProfiler();
+
+	/*----------------------------------------------------
+		Recording
+	----------------------------------------------------*/
+
+	/** Start recording a day, overwriting the oldest one */
+	void BeginDay(int64 Date);
+
+	/** Record the time spent since the end of the previous phase */
+	void EndPhase(EFlareSimulationPhase::Type Phase);
+
+	/** Finish the current day */
+	void EndDay();
+
+	/** Add the cost of a company AI step to the current day. Ignored outside of a day or off the game thread. */
+	void AddAIStep(UFlareCompany* Company, EFlareAIStep::Type Step, double Time, uint32 Allocations);
+
+
+	/*----------------------------------------------------
+		Output
+	----------------------------------------------------*/
+
+	/** Write all recorded days as CSV, one line per phase and per company AI step */
+	bool SaveCSV(const FString& Path) const;
+
+	/** Get the machine-readable name of a simulation phase */
+	static FString GetPhaseName(EFlareSimulationPhase::Type Phase);
+
+	/** Get the machine-readable name of an AI step */
+	static FString GetAIStepName(EFlareAIStep::Type Step);
+
+	/** Get the number of allocations done by the process so far, or 0 if the build doesn't count them */
+	static uint32 GetAllocationCount();
+
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	/** Get the number of recorded days */
+	inline int32 Num() const
+	{
+		return DayCount;
+	}
+
+	/** Get a recorded day, 0 being the oldest */
+	inline const FFlareSimulationTimings& GetDay(int32 Index) const
+	{
+		return Days[(NextDayIndex - DayCount + Index + Days.Num()) % Days.Num()];
+	}
+
+	/** Get the last simulated day */
+	inline const FFlareSimulationTimings& GetLastDay() const
+	{
+		return Days[(NextDayIndex - 1 + Days.Num()) % Days.Num()];
+	}
+
+	inline bool IsDayRunning() const
+	{
+		return DayRunning;
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	// Ring buffer of days
+	TArray<FFlareSimulationTimings>  Days;
+	int32                            NextDayIndex;
+	int32                            DayCount;
+
+	// Current day
+	bool                             DayRunning;
+	double                           DayStartTime;
+	uint32                           DayStartAllocations;
+	double                           PhaseStartTime;
+	uint32                           PhaseStartCycles;
+	uint32                           PhaseStartAllocations;
+
+};
+
+
+/** Adds the cost of a company AI step to the world profiler when going out of scope */
+struct FFlareScopedAIStepProfile
+{
+public:
+
+	FFlareScopedAIStepProfile(UFlareCompany* TargetCompany, EFlareAIStep::Type TargetStep);
+
+	~FFlareScopedAIStepProfile();
+
+
+protected:
+
+	UFlareCompany*                   Company;
+	EFlareAIStep::Type               Step;
+	double                           StartTime;
+	uint32                           StartAllocations;
+
+};
@@ -29,6 +29,7 @@ static const double TRAVEL_DURATION_PER_ALTITUDE_KM = 1.5;
 UFlareTravel::UFlareTravel(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	SaveDirty = true;
 }
 
 void UFlareTravel::Load(const FFlareTravelSave& Data)
@@ -36,6 +37,7 @@ void UFlareTravel::Load(const FFlareTravelSave& Data)
 	Game = Cast<UFlareWorld>(GetOuter())->GetGame();
 	TravelData = Data;
 	TravelShips.Empty();
+	SaveDirty = true;
 
 	Fleet = Game->GetGameWorld()->FindFleet(TravelData.FleetIdentifier);
 	DestinationSector = Game->GetGameWorld()->FindSector(TravelData.DestinationSectorIdentifier);
@@ -83,6 +85,7 @@ void UFlareTravel::Load(const FFlareTravelSave& Data)
 
 FFlareTravelSave* UFlareTravel::Save()
 {
+	SaveDirty = false;
 	return &TravelData;
 }
 
@@ -371,6 +374,7 @@ void UFlareTravel::ChangeDestination(UFlareSimulatedSector* NewDestinationSector
 	// TODO intelligent travel remaining duration change
 	TravelData.DepartureDate = Game->GetGameWorld()->GetDate();
 	GenerateTravelDuration();
+	SaveDirty = true;
 }
 
 bool UFlareTravel::CanChangeDestination()
@@ -385,6 +389,25 @@ void UFlareTravel::GenerateTravelDuration()
 }
 
 int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company)
+{
+	if (OriginSector == DestinationSector)
+	{
+		return 0;
+	}
+
+	bool FastTravel = (Company && Company->IsTechnologyUnlocked("fast-travel"));
+
+	// World sectors are served from the precomputed matrix
+	int64 CachedTravelDuration = World->GetCachedTravelDuration(OriginSector, DestinationSector, FastTravel);
+	if (CachedTravelDuration >= 0)
+	{
+		return CachedTravelDuration;
+	}
+
+	return ComputeTravelDurationFromOrbits(World, OriginSector, DestinationSector, FastTravel);
+}
+
+int64 UFlareTravel::ComputeTravelDurationFromOrbits(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel)
 {
 	int64 TravelDuration = 0;
 
@@ -424,7 +447,7 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 		TravelDuration = (UFlareGameTools::SECONDS_IN_DAY/2 + ComputeAltitudeTravelDuration(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude)) / UFlareGameTools::SECONDS_IN_DAY;
 	}
 
-	if(Company && Company->IsTechnologyUnlocked("fast-travel"))
+	if (FastTravel)
 	{
 		TravelDuration /= 2;
 	}
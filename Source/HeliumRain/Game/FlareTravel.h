@@ -56,6 +56,12 @@ public:
 	/** Save the travel to a save file */
 	virtual FFlareTravelSave* Save();
 
+	/** Check if the travel changed since it was last saved */
+	inline bool IsSaveDirty() const
+	{
+		return SaveDirty;
+	}
+
 
 	/*----------------------------------------------------
 		Gameplay
@@ -81,8 +87,12 @@ public:
 
 	FFlareSectorOrbitParameters ComputeCurrentTravelLocation();
 
+	/** Get the travel duration in days, served from the world travel matrix when possible */
 	static int64 ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company);
 
+	/** Compute the travel duration in days from the sector orbits, without any cache */
+	static int64 ComputeTravelDurationFromOrbits(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel);
+
 	static int64 ComputePhaseTravelDuration(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase);
 
 	static int64 ComputeAltitudeTravelDuration(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude);
@@ -119,6 +129,7 @@ protected:
 	FFlareSectorDescription          SectorDescription;
 
 	FFlareTravelSave                        TravelData;
+	bool                                    SaveDirty;
 	AFlareGame*                             Game;
 	int64                                   TravelDuration;
 
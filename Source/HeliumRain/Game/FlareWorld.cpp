@@ -2,17 +2,22 @@
 #include "FlareWorld.h"
 #include "../Flare.h"
 
+#include "Async/ParallelFor.h"
+
 #include "../Data/FlareSpacecraftCatalog.h"
 #include "../Data/FlareSectorCatalogEntry.h"
+#include "../Data/FlareResourceCatalog.h"
 
 #include "../Economy/FlareFactory.h"
 
 #include "FlareGame.h"
 #include "FlareGameTools.h"
+#include "FlareWorldHelper.h"
 #include "FlareSector.h"
 #include "FlareTravel.h"
 #include "FlareFleet.h"
 #include "FlareBattle.h"
+#include "AI/FlareCompanyAI.h"
 
 #include "../Quests/FlareQuest.h"
 #include "../Quests/FlareQuestCondition.h"
@@ -20,6 +25,10 @@
 #include "../Player/FlarePlayerController.h"
 #include "../Player/FlareMenuManager.h"
 
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Save"), STAT_FlareWorld_Save, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld UpdateIncomingEvents"), STAT_FlareWorld_UpdateIncomingEvents, STATGROUP_Flare);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FlareWorld Save rewrites"), STAT_FlareWorld_SaveRewrites, STATGROUP_Flare);
+
 #define LOCTEXT_NAMESPACE "FlareWorld"
 
 /*----------------------------------------------------
@@ -29,13 +38,22 @@
 UFlareWorld::UFlareWorld(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	TravelDurationsValid = false;
+	BatchSimulation = false;
+	SaveSnapshotValid = false;
+	LastSaveRewriteCount = 0;
+	IncomingEventsValid = false;
+	IncomingEventsDate = -1;
+	IncomingEventsVersion = 0;
 }
 
 void UFlareWorld::Load(const FFlareWorldSave& Data)
 {
 	FLOG("UFlareWorld::Load");
+	double StartTs = FPlatformTime::Seconds();
 	Game = Cast<AFlareGame>(GetOuter());
     WorldData = Data;
+	SaveSnapshotValid = false;
 
 	// Init planetarium
 	Planetarium = NewObject<UFlareSimulatedPlanetarium>(this, UFlareSimulatedPlanetarium::StaticClass());
@@ -46,6 +64,18 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
     {
 		LoadCompany(WorldData.CompanyData[i]);
     }
+	double CompaniesTs = FPlatformTime::Seconds();
+
+	// Index sector saves, the first one of an identifier wins
+	TMap<FName, FFlareSectorSave*> SectorSaves;
+	SectorSaves.Reserve(WorldData.SectorData.Num());
+	for (int32 i = 0; i < WorldData.SectorData.Num(); i++)
+	{
+		if (!SectorSaves.Contains(WorldData.SectorData[i].Identifier))
+		{
+			SectorSaves.Add(WorldData.SectorData[i].Identifier, &WorldData.SectorData[i]);
+		}
+	}
 
 	// Load sectors
 	TArray<UFlareSectorCatalogEntry*> SectorList = Game->GetSectorCatalog();
@@ -54,16 +84,7 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
 		const FFlareSectorDescription* SectorDescription = &SectorList[SectorIndex]->Data;
 
 		// Find save if exist
-		FFlareSectorSave* SectorSave = NULL;
-		for (int32 i = 0; i < WorldData.SectorData.Num(); i++)
-		{
-			if (WorldData.SectorData[i].Identifier == SectorDescription->Identifier)
-			{
-				// Old save found
-				SectorSave = &WorldData.SectorData[i];
-				break;
-			}
-		}
+		FFlareSectorSave* SectorSave = SectorSaves.FindRef(SectorDescription->Identifier);
 
 		FFlareSectorSave NewSectorData;
 		if (!SectorSave)
@@ -103,6 +124,8 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
 		LoadSector(SectorDescription, *SectorSave, OrbitParameters);
 	}
 
+	double SectorsTs = FPlatformTime::Seconds();
+
 	// Load all travels
 	for (int32 i = 0; i < WorldData.TravelData.Num(); i++)
 	{
@@ -110,14 +133,22 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
 	}
 
 	WorldMoneyReferenceInit = false;
+
+	double EndTs = FPlatformTime::Seconds();
+	FLOGV("UFlareWorld::Load : companies %.2fms, sectors %.2fms, travels %.2fms",
+		(CompaniesTs - StartTs) * 1000, (SectorsTs - CompaniesTs) * 1000, (EndTs - SectorsTs) * 1000);
 }
 
 void UFlareWorld::PostLoad()
 {
+	double StartTs = FPlatformTime::Seconds();
+
 	for (int i = 0; i < Companies.Num(); i++)
 	{
 		Companies[i]->PostLoad();
 	}
+
+	FLOGV("UFlareWorld::PostLoad : linked %d companies in %.2fms", Companies.Num(), (FPlatformTime::Seconds() - StartTs) * 1000);
 }
 
 UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
@@ -128,6 +159,8 @@ UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
 	Company = NewObject<UFlareCompany>(this, UFlareCompany::StaticClass(), CompanyData.Identifier);
     Company->Load(CompanyData);
     Companies.AddUnique(Company);
+	Company->SetWorldIndex(Companies.Num() - 1);
+	UpdateHostilities();
 
 	//FLOGV("UFlareWorld::LoadCompany : loaded '%s'", *Company->GetCompanyName().ToString());
 
@@ -143,6 +176,9 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 	Sector = NewObject<UFlareSimulatedSector>(this, UFlareSimulatedSector::StaticClass(), SectorData.Identifier);
 	Sector->Load(Description, SectorData, OrbitParameters);
 	Sectors.AddUnique(Sector);
+	Sector->SetWorldIndex(Sectors.Num() - 1);
+	SectorIndex.Add(Sector->GetIdentifier(), Sector);
+	InvalidateTravelDurations();
 
 	//FLOGV("UFlareWorld::LoadSector : loaded '%s'", *Sector->GetSectorName().ToString());
 
@@ -165,41 +201,241 @@ UFlareTravel* UFlareWorld::LoadTravel(const FFlareTravelSave& TravelData)
 }
 
 
+/*----------------------------------------------------
+	Identifier indices
+----------------------------------------------------*/
+
+void UFlareWorld::RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
+{
+	UnregisterSpacecraft(Spacecraft);
+
+	if (Spacecraft->IsDestroyed())
+	{
+		// Several destroyed spacecrafts can share an immatriculation, keep the first one
+		if (!DestroyedSpacecraftIndex.Contains(Spacecraft->GetImmatriculation()))
+		{
+			DestroyedSpacecraftIndex.Add(Spacecraft->GetImmatriculation(), Spacecraft);
+		}
+	}
+	else
+	{
+		SpacecraftIndex.Add(Spacecraft->GetImmatriculation(), Spacecraft);
+	}
+}
+
+void UFlareWorld::UnregisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
+{
+	FName Immatriculation = Spacecraft->GetImmatriculation();
+
+	UFlareSimulatedSpacecraft** Entry = SpacecraftIndex.Find(Immatriculation);
+	if (Entry && *Entry == Spacecraft)
+	{
+		SpacecraftIndex.Remove(Immatriculation);
+	}
+
+	Entry = DestroyedSpacecraftIndex.Find(Immatriculation);
+	if (Entry && *Entry == Spacecraft)
+	{
+		DestroyedSpacecraftIndex.Remove(Immatriculation);
+	}
+}
+
+void UFlareWorld::RegisterFleet(UFlareFleet* Fleet)
+{
+	FleetIndex.Add(Fleet->GetIdentifier(), Fleet);
+}
+
+void UFlareWorld::UnregisterFleet(UFlareFleet* Fleet)
+{
+	UFlareFleet** Entry = FleetIndex.Find(Fleet->GetIdentifier());
+	if (Entry && *Entry == Fleet)
+	{
+		FleetIndex.Remove(Fleet->GetIdentifier());
+	}
+}
+
+void UFlareWorld::RegisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	TradeRouteIndex.Add(TradeRoute->GetIdentifier(), TradeRoute);
+}
+
+void UFlareWorld::UnregisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	UFlareTradeRoute** Entry = TradeRouteIndex.Find(TradeRoute->GetIdentifier());
+	if (Entry && *Entry == TradeRoute)
+	{
+		TradeRouteIndex.Remove(TradeRoute->GetIdentifier());
+	}
+}
+
+bool UFlareWorld::CheckIndices()
+{
+	bool Integrity = true;
+	int32 SpacecraftCount = 0;
+	int32 FleetCount = 0;
+	int32 TradeRouteCount = 0;
+
+	// Every listed object must be indexed
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		if (FindSector(Sector->GetIdentifier()) != Sector)
+		{
+			FLOGV("WARNING : World integrity failure : sector %s is not indexed", *Sector->GetIdentifier().ToString());
+			Integrity = false;
+		}
+	}
+
+	for (UFlareCompany* Company : Companies)
+	{
+		for (UFlareSimulatedSpacecraft* Spacecraft : Company->GetCompanySpacecrafts())
+		{
+			if (SpacecraftIndex.FindRef(Spacecraft->GetImmatriculation()) != Spacecraft)
+			{
+				FLOGV("WARNING : World integrity failure : spacecraft %s is not indexed", *Spacecraft->GetImmatriculation().ToString());
+				Integrity = false;
+			}
+		}
+		SpacecraftCount += Company->GetCompanySpacecrafts().Num();
+
+		for (UFlareFleet* Fleet : Company->GetCompanyFleets())
+		{
+			if (FleetIndex.FindRef(Fleet->GetIdentifier()) != Fleet)
+			{
+				FLOGV("WARNING : World integrity failure : fleet %s is not indexed", *Fleet->GetIdentifier().ToString());
+				Integrity = false;
+			}
+		}
+		FleetCount += Company->GetCompanyFleets().Num();
+
+		for (UFlareTradeRoute* TradeRoute : Company->GetCompanyTradeRoutes())
+		{
+			if (TradeRouteIndex.FindRef(TradeRoute->GetIdentifier()) != TradeRoute)
+			{
+				FLOGV("WARNING : World integrity failure : trade route %s is not indexed", *TradeRoute->GetIdentifier().ToString());
+				Integrity = false;
+			}
+		}
+		TradeRouteCount += Company->GetCompanyTradeRoutes().Num();
+	}
+
+	// No stale entries
+	if (SpacecraftIndex.Num() != SpacecraftCount || FleetIndex.Num() != FleetCount || TradeRouteIndex.Num() != TradeRouteCount)
+	{
+		FLOGV("WARNING : World integrity failure : %d spacecrafts, %d fleets, %d trade routes indexed but %d, %d, %d listed",
+			SpacecraftIndex.Num(), FleetIndex.Num(), TradeRouteIndex.Num(),
+			SpacecraftCount, FleetCount, TradeRouteCount);
+		Integrity = false;
+	}
+
+	for (auto& Entry : DestroyedSpacecraftIndex)
+	{
+		if (!Entry.Value->IsDestroyed())
+		{
+			FLOGV("WARNING : World integrity failure : spacecraft %s is indexed as destroyed", *Entry.Key.ToString());
+			Integrity = false;
+		}
+	}
+
+	return Integrity;
+}
+
+
 FFlareWorldSave* UFlareWorld::Save()
 {
-	WorldData.CompanyData.Empty();
-	WorldData.SectorData.Empty();
-	WorldData.TravelData.Empty();
+	SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Save);
+
+	// The snapshot entries can be kept if they still describe the same objects in the same order
+	bool SameCompanies = SaveSnapshotValid && WorldData.CompanyData.Num() == Companies.Num();
+	for (int i = 0; SameCompanies && i < Companies.Num(); i++)
+	{
+		SameCompanies = (WorldData.CompanyData[i].Identifier == Companies[i]->GetIdentifier());
+	}
+
+	bool SameSectors = SaveSnapshotValid && WorldData.SectorData.Num() == Sectors.Num();
+	for (int i = 0; SameSectors && i < Sectors.Num(); i++)
+	{
+		SameSectors = (WorldData.SectorData[i].Identifier == Sectors[i]->GetIdentifier());
+	}
+
+	bool SameTravels = SaveSnapshotValid && WorldData.TravelData.Num() == Travels.Num();
+	for (int i = 0; SameTravels && i < Travels.Num(); i++)
+	{
+		SameTravels = (WorldData.TravelData[i].FleetIdentifier == Travels[i]->GetFleet()->GetIdentifier());
+	}
+
+	LastSaveRewriteCount = 0;
+
+	// Objects don't track the changes made by the simulation, flag them all
+	if (!SaveSnapshotValid)
+	{
+		for (UFlareCompany* Company : Companies)
+		{
+			Company->MarkSaveDirty();
+			for (UFlareSimulatedSpacecraft* Spacecraft : Company->GetCompanySpacecrafts())
+			{
+				Spacecraft->MarkSaveDirty();
+			}
+		}
+	}
 
 	// Companies
+	if (!SameCompanies)
+	{
+		WorldData.CompanyData.Reset(Companies.Num());
+		WorldData.CompanyData.AddDefaulted(Companies.Num());
+	}
 	for (int i = 0; i < Companies.Num(); i++)
 	{
 		UFlareCompany* Company = Companies[i];
 
-		//FLOGV("UFlareWorld::Save : saving company ('%s')", *Company->GetName());
-		FFlareCompanySave* TempData = Company->Save();
-		WorldData.CompanyData.Add(*TempData);
+		if (!SameCompanies || Company->IsSaveDirty())
+		{
+			//FLOGV("UFlareWorld::Save : saving company ('%s')", *Company->GetName());
+			Company->Save(WorldData.CompanyData[i]);
+			LastSaveRewriteCount += 1 + Company->GetLastSaveRewriteCount();
+		}
 	}
 
 	// Sectors
+	if (!SameSectors)
+	{
+		WorldData.SectorData.Reset(Sectors.Num());
+		WorldData.SectorData.AddDefaulted(Sectors.Num());
+	}
 	for (int i = 0; i < Sectors.Num(); i++)
 	{
 		UFlareSimulatedSector* Sector = Sectors[i];
-		//FLOGV("UFlareWorld::Save : saving sector ('%s')", *Sector->GetName());
 
-		WorldData.SectorData.Add(*Sector->Save());
+		if (!SameSectors || Sector->IsSaveDirty())
+		{
+			//FLOGV("UFlareWorld::Save : saving sector ('%s')", *Sector->GetName());
+			WorldData.SectorData[i] = *Sector->Save();
+			LastSaveRewriteCount++;
+		}
 	}
 
 	// Travels
+	if (!SameTravels)
+	{
+		WorldData.TravelData.Reset(Travels.Num());
+		WorldData.TravelData.AddDefaulted(Travels.Num());
+	}
 	for (int i = 0; i < Travels.Num(); i++)
 	{
 		UFlareTravel* Travel = Travels[i];
 
-		//FLOGV("UFlareWorld::Save : saving travel for ('%s')", *Travel->GetFleet()->GetFleetName().ToString());
-		FFlareTravelSave* TempData = Travel->Save();
-		WorldData.TravelData.Add(*TempData);
+		if (!SameTravels || Travel->IsSaveDirty())
+		{
+			//FLOGV("UFlareWorld::Save : saving travel for ('%s')", *Travel->GetFleet()->GetFleetName().ToString());
+			WorldData.TravelData[i] = *Travel->Save();
+			LastSaveRewriteCount++;
+		}
 	}
 
+	SaveSnapshotValid = true;
+	SET_DWORD_STAT(STAT_FlareWorld_SaveRewrites, LastSaveRewriteCount);
+	FLOGV("UFlareWorld::Save : rewrote %d objects", LastSaveRewriteCount);
+
 	return &WorldData;
 }
 
@@ -407,6 +643,15 @@ bool UFlareWorld::CheckIntegrity()
 			}
 		}
 	}
+
+#if !UE_BUILD_SHIPPING
+	// Check identifier indices
+	if (!CheckIndices())
+	{
+		Integrity = false;
+	}
+#endif
+
 	return Integrity;
 }
 
@@ -416,6 +661,11 @@ void UFlareWorld::Simulate()
 	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 	Game->GetPC()->MarkAsBusy();
 
+	SimulationProfiler.BeginDay(WorldData.Date);
+
+	// A day changes most of the world, the next save will rewrite everything
+	SaveSnapshotValid = false;
+
 	/**
 	 *  End previous day
 	 */
@@ -480,10 +730,17 @@ void UFlareWorld::Simulate()
 		}
 	}
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Battles);
 	FLOG("* Simulate > AI");
 
 	HasTotalWorldCombatPointCache = false;
 
+	// Shared economy data for all companies
+	UpdateEconomySnapshot();
+
+	// Plan the day for all companies against the same world state
+	PlanCompanyAI();
+
 	// AI. Play them in random order
 	TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
 	while(CompaniesToSimulateAI.Num())
@@ -519,6 +776,7 @@ void UFlareWorld::Simulate()
 	/**
 	 *  Begin day
 	 */
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::AI);
 	FLOG("* Simulate > New day");
 
 	WorldData.Date++;
@@ -639,6 +897,8 @@ void UFlareWorld::Simulate()
 	ProcessShipCapture();
 	ProcessStationCapture();
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::NewDay);
+
 	// Factories
 	FLOG("* Simulate > Factories");
 	for (UFlareFactory* Factory: Factories)
@@ -655,6 +915,8 @@ void UFlareWorld::Simulate()
 	}
 
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Factories);
+
 	// Peoples
 	FLOG("* Simulate > Peoples");
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
@@ -663,6 +925,8 @@ void UFlareWorld::Simulate()
 	}
 
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::People);
+
 	FLOG("* Simulate > Trade routes");
 
 	// Trade routes
@@ -675,6 +939,7 @@ void UFlareWorld::Simulate()
 			TradeRoutes[RouteIndex]->Simulate();
 		}
 	}
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::TradeRoutes);
 	FLOG("* Simulate > Travels");
 
 	// Undock and make move AI ships
@@ -698,6 +963,8 @@ void UFlareWorld::Simulate()
 		TravelsToProcess[TravelIndex]->Simulate();
 	}
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Travels);
+
 	FLOG("* Simulate > Reputation");
 	// Reputation stabilization
 	if(Game->GetPC()->GetCompany()->GetGame() > 0)
@@ -712,6 +979,8 @@ void UFlareWorld::Simulate()
 	}
 
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Reputation);
+
 	FLOG("* Simulate > Prices");
 	// Price variation.
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
@@ -719,8 +988,12 @@ void UFlareWorld::Simulate()
 		Sectors[SectorIndex]->SimulatePriceVariation();
 	}
 
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Prices);
+
 	// People money migration
+	FLOG("* Simulate > Migration");
 	SimulatePeopleMoneyMigration();
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::Migration);
 
 	// Process events
 
@@ -755,27 +1028,76 @@ void UFlareWorld::Simulate()
 
 	GameLog::DaySimulated(WorldData.Date);
 
-	// Check recovery
+	// Player-facing checks are done once at the end of a batch
+	if (!BatchSimulation)
 	{
-		// Check if it the last ship
-		bool EmptyFleet = true;
-		for(int ShipIndex = 0; ShipIndex < GetGame()->GetPC()->GetPlayerFleet()->GetShips().Num(); ShipIndex++)
+		CheckPlayerState();
+	}
+
+	InvalidateIncomingEvents();
+
+	SimulationProfiler.EndPhase(EFlareSimulationPhase::EndDay);
+	SimulationProfiler.EndDay();
+}
+
+int32 UFlareWorld::SimulateDays(int32 DayCount)
+{
+	AFlarePlayerController* PC = Game->GetPC();
+	int32 SimulatedDays = 0;
+
+	FLOGV("UFlareWorld::SimulateDays : simulate up to %d days", DayCount);
+
+	BatchSimulation = true;
+	PC->BeginDeferredNotifications();
+
+	while (SimulatedDays < DayCount)
+	{
+		TArray<FName> IncomingEventIdentifiers = GetIncomingEventIdentifiers();
+
+		Simulate();
+		SimulatedDays++;
+
+		// Stop when incoming events appear or resolve, when a notification would stop fast forward, or when the player is in trouble
+		if (GetIncomingEventIdentifiers() != IncomingEventIdentifiers
+		 || PC->HasDeferredStopNotification()
+		 || IsPlayerFleetDisabled())
 		{
-			UFlareSimulatedSpacecraft* Ship = GetGame()->GetPC()->GetPlayerFleet()->GetShips()[ShipIndex];
-			if(Ship->GetDamageSystem()->IsAlive() && !Ship->GetDamageSystem()->IsUncontrollable())
-			{
-				EmptyFleet = false;
-				break;
-			}
+			break;
 		}
+	}
+
+	BatchSimulation = false;
+	PC->EndDeferredNotifications();
+	CheckPlayerState();
 
-		// If last, activate recovery
-		if (EmptyFleet)
+	FLOGV("UFlareWorld::SimulateDays : %d days simulated", SimulatedDays);
+	return SimulatedDays;
+}
+
+bool UFlareWorld::IsPlayerFleetDisabled()
+{
+	for (int ShipIndex = 0; ShipIndex < GetGame()->GetPC()->GetPlayerFleet()->GetShips().Num(); ShipIndex++)
+	{
+		UFlareSimulatedSpacecraft* Ship = GetGame()->GetPC()->GetPlayerFleet()->GetShips()[ShipIndex];
+		if (Ship->GetDamageSystem()->IsAlive() && !Ship->GetDamageSystem()->IsUncontrollable())
 		{
-			GetGame()->GetPC()->GetMenuManager()->OpenMenu(EFlareMenu::MENU_GameOver);
+			return false;
 		}
 	}
 
+	return true;
+}
+
+void UFlareWorld::CheckPlayerState()
+{
+	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
+
+	// If the last ship is lost, activate recovery
+	if (IsPlayerFleetDisabled())
+	{
+		GetGame()->GetPC()->GetMenuManager()->OpenMenu(EFlareMenu::MENU_GameOver);
+	}
+
 	// Check player position in leaderboard
 	bool IsFirst = true;
 	bool IsLast = true;
@@ -1189,11 +1511,6 @@ void UFlareWorld::SimulatePeopleMoneyMigration()
 	}
 }
 
-void UFlareWorld::FastForward()
-{
-	Simulate();
-}
-
 TMap<IncomingKey, IncomingValue> UFlareWorld::GetIncomingPlayerEnemy()
 {
 	// List sector with player possesion
@@ -1592,6 +1909,132 @@ void UFlareWorld::AddFactory(UFlareFactory* Factory)
 	Factories.Add(Factory);
 }
 
+int64 UFlareWorld::GetCachedTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel)
+{
+	int32 OriginIndex = OriginSector->GetWorldIndex();
+	int32 DestinationIndex = DestinationSector->GetWorldIndex();
+
+	if (OriginIndex == INDEX_NONE || DestinationIndex == INDEX_NONE)
+	{
+		return -1;
+	}
+
+	if (!TravelDurationsValid)
+	{
+		UpdateTravelDurations();
+	}
+
+	int32 SectorCount = Sectors.Num();
+	int32 Tier = (FastTravel ? 1 : 0);
+	return TravelDurations[(Tier * SectorCount + OriginIndex) * SectorCount + DestinationIndex];
+}
+
+void UFlareWorld::InvalidateTravelDurations()
+{
+	TravelDurationsValid = false;
+}
+
+void UFlareWorld::UpdateHostility(UFlareCompany* Company, UFlareCompany* TargetCompany)
+{
+	int32 CompanyCount = Companies.Num();
+	int32 IndexA = Company->GetWorldIndex();
+	int32 IndexB = TargetCompany->GetWorldIndex();
+
+	if (IndexA == INDEX_NONE || IndexB == INDEX_NONE)
+	{
+		return;
+	}
+
+	EFlareHostility::Type HostilityAB = Company->ComputeHostility(TargetCompany);
+	EFlareHostility::Type HostilityBA = TargetCompany->ComputeHostility(Company);
+	Hostilities[IndexA * CompanyCount + IndexB] = HostilityAB;
+	Hostilities[IndexB * CompanyCount + IndexA] = HostilityBA;
+
+	// War state is hostile if at least one company is hostile
+	bool AtWar = (HostilityAB == EFlareHostility::Hostile || HostilityBA == EFlareHostility::Hostile);
+	bool WasAtWar = (WarStates[IndexA * CompanyCount + IndexB] == EFlareHostility::Hostile);
+	WarStates[IndexA * CompanyCount + IndexB] = (AtWar ? EFlareHostility::Hostile : HostilityAB);
+	WarStates[IndexB * CompanyCount + IndexA] = (AtWar ? EFlareHostility::Hostile : HostilityBA);
+
+	// Day plans read the war state with station owners
+	if (AtWar != WasAtWar)
+	{
+		Company->GetAI()->InvalidatePlan();
+		TargetCompany->GetAI()->InvalidatePlan();
+	}
+}
+
+void UFlareWorld::UpdateHostilities()
+{
+	int32 CompanyCount = Companies.Num();
+	Hostilities.SetNumUninitialized(CompanyCount * CompanyCount);
+	WarStates.SetNumUninitialized(CompanyCount * CompanyCount);
+
+	for (int32 IndexA = 0; IndexA < CompanyCount; IndexA++)
+	{
+		for (int32 IndexB = IndexA; IndexB < CompanyCount; IndexB++)
+		{
+			UpdateHostility(Companies[IndexA], Companies[IndexB]);
+		}
+	}
+}
+
+void UFlareWorld::UpdateEconomySnapshot()
+{
+	if (!EconomySnapshot.IsValid())
+	{
+		EconomySnapshot = MakeShareable(new FFlareEconomySnapshot());
+	}
+
+	WorldHelper::ComputeEconomySnapshot(Game, *EconomySnapshot);
+}
+
+void UFlareWorld::PlanCompanyAI()
+{
+	// Fill the lazy caches the planning pass reads, so that it doesn't write anything shared
+	GetEconomySnapshot();
+	Game->GetAINerfRatio();
+
+	for (UFlareFactory* Factory : Factories)
+	{
+		Factory->GetCycleData();
+	}
+
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		for (UFlareResourceCatalogEntry* Resource : Game->GetResourceCatalog()->Resources)
+		{
+			Sector->GetResourcePrice(&Resource->Data, EFlareResourcePriceContext::Default);
+		}
+	}
+
+	// Each company only writes its own plan : the result doesn't depend on scheduling
+	ParallelFor(Companies.Num(), [&](int32 CompanyIndex)
+	{
+		Companies[CompanyIndex]->GetAI()->Plan();
+	});
+}
+
+void UFlareWorld::UpdateTravelDurations()
+{
+	int32 SectorCount = Sectors.Num();
+	TravelDurations.SetNumUninitialized(2 * SectorCount * SectorCount);
+
+	for (int32 Tier = 0; Tier < 2; Tier++)
+	{
+		for (int32 OriginIndex = 0; OriginIndex < SectorCount; OriginIndex++)
+		{
+			for (int32 DestinationIndex = 0; DestinationIndex < SectorCount; DestinationIndex++)
+			{
+				TravelDurations[(Tier * SectorCount + OriginIndex) * SectorCount + DestinationIndex] =
+					UFlareTravel::ComputeTravelDurationFromOrbits(this, Sectors[OriginIndex], Sectors[DestinationIndex], Tier == 1);
+			}
+		}
+	}
+
+	TravelDurationsValid = true;
+}
+
 
 UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimulatedSector* DestinationSector, bool Force)
 {
@@ -1602,6 +2045,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 
 	if (TravelingFleet->IsTraveling())
 	{
+		InvalidateIncomingEvents();
 		TravelingFleet->GetCurrentTravel()->ChangeDestination(DestinationSector);
 		return TravelingFleet->GetCurrentTravel();
 	}
@@ -1668,6 +2112,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 		UFlareTravel* Travel = LoadTravel(TravelData);
 
 		GetGame()->GetQuestManager()->OnTravelStarted(Travel);
+		InvalidateIncomingEvents();
 
 		return Travel;
 	}
@@ -1676,6 +2121,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 void UFlareWorld::DeleteTravel(UFlareTravel* Travel)
 {
 	Travels.Remove(Travel);
+	InvalidateIncomingEvents();
 }
 
 /*----------------------------------------------------
@@ -1713,84 +2159,36 @@ UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
 
 UFlareSimulatedSector* UFlareWorld::FindSector(FName Identifier) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
-	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		if (Sector->GetIdentifier() == Identifier)
-		{
-			return Sector;
-		}
-	}
-
-	return NULL;
+	return SectorIndex.FindRef(Identifier);
 }
 
-UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
+UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftImmatriculation) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
-	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		for (int j = 0; j < Sector->GetSectorSpacecrafts().Num(); j++)
-		{
-			if (Sector->GetSectorSpacecrafts()[j]->GetDescription()->Identifier == SpacecraftIdentifier)
-			{
-				return Sector;
-			}
-		}
-	}
-	return NULL;
+	UFlareSimulatedSpacecraft* Spacecraft = SpacecraftIndex.FindRef(SpacecraftImmatriculation);
+	return Spacecraft ? Spacecraft->GetCurrentSector() : NULL;
 }
 
 UFlareFleet* UFlareWorld::FindFleet(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareFleet* Fleet = Company->FindFleet(Identifier);
-		if (Fleet)
-		{
-			return Fleet;
-		}
-	}
-	return NULL;
+	return FleetIndex.FindRef(Identifier);
 }
 
 UFlareTradeRoute* UFlareWorld::FindTradeRoute(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareTradeRoute* TradeRoute = Company->FindTradeRoute(Identifier);
-		if (TradeRoute)
-		{
-			return TradeRoute;
-		}
-	}
-	return NULL;
+	return TradeRouteIndex.FindRef(Identifier);
 }
 
 UFlareSimulatedSpacecraft* UFlareWorld::FindSpacecraft(FName ShipImmatriculation)
 {
-	for (UFlareCompany* Company : Companies)
-	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
-	}
+	UFlareSimulatedSpacecraft* Spacecraft = SpacecraftIndex.FindRef(ShipImmatriculation);
 
 	// Now check destroyed ships
-	for (UFlareCompany* Company : Companies)
+	if (!Spacecraft)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation, true);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
+		Spacecraft = DestroyedSpacecraftIndex.FindRef(ShipImmatriculation);
 	}
 
-	return NULL;
+	return Spacecraft;
 }
 
 
@@ -1848,9 +2246,38 @@ uint32 UFlareWorld::GetWorldPopulation()
 
 	return WorldPopulation;
 }
-TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
+
+const TArray<FFlareIncomingEvent>& UFlareWorld::GetIncomingEvents()
+{
+	if (!IncomingEventsValid || IncomingEventsDate != WorldData.Date)
+	{
+		UpdateIncomingEvents();
+	}
+
+	return IncomingEvents;
+}
+
+TArray<FName> UFlareWorld::GetIncomingEventIdentifiers()
 {
-	TArray<FFlareIncomingEvent> IncomingEvents;
+	TArray<FName> Identifiers;
+	for (const FFlareIncomingEvent& Event : GetIncomingEvents())
+	{
+		Identifiers.Add(Event.Identifier);
+	}
+
+	Identifiers.Sort(FNameLexicalLess());
+	return Identifiers;
+}
+
+void UFlareWorld::UpdateIncomingEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareWorld_UpdateIncomingEvents);
+
+	IncomingEvents.Reset();
+	IncomingEventsValid = true;
+	IncomingEventsDate = WorldData.Date;
+	IncomingEventsVersion++;
+
 	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 	FText SingleShip = LOCTEXT("ShipSingle", "ship");
 	FText MultipleShips = LOCTEXT("ShipPlural", "ships");
@@ -1931,6 +2358,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 			FFlareIncomingEvent TravelEvent;
 			TravelEvent.Text = TravelText;
 			TravelEvent.RemainingDuration = RemainingDuration;
+			TravelEvent.Identifier = FName(*("threat-" + Company->GetIdentifier().ToString() + "-" + Sector->GetIdentifier().ToString()));
 			IncomingEvents.Add(TravelEvent);
 		}
 	}
@@ -1973,6 +2401,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 			{
 				FFlareIncomingEvent Event;
 				Event.RemainingDuration = DangerDelay;
+				Event.Identifier = FName(*("meteorite-" + Sector->GetIdentifier().ToString()));
 
 				FText MeteoriteText = (DangerCount > 1 ? LOCTEXT("MultipleMeteorites", "meteorites") : LOCTEXT("OneMeteorite", "meteorite"));
 
@@ -2035,6 +2464,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 			FFlareIncomingEvent TravelEvent;
 			TravelEvent.Text = TravelText;
 			TravelEvent.RemainingDuration = RemainingDuration;
+			TravelEvent.Identifier = FName(*("travel-" + Travel->GetFleet()->GetIdentifier().ToString()));
 			IncomingEvents.Add(TravelEvent);
 		}
 	}
@@ -2086,15 +2516,16 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 					FFlareIncomingEvent ProductionEvent;
 					ProductionEvent.Text = ProductionText;
 					ProductionEvent.RemainingDuration = ProductionTime;
+					ProductionEvent.Identifier = FName(*("production-" + CompanyStation->GetImmatriculation().ToString() + "-" + FString::FromInt(FactoryIndex)));
 					IncomingEvents.Add(ProductionEvent);
 				}
 			}
 
-			TArray<FFlareShipyardOrderSave>& Orders = CompanyStation->GetShipyardOrderQueue();
+			const TArray<FFlareShipyardOrderSave>& Orders = CompanyStation->GetShipyardOrderQueue();
 
 			for(int32 i = 0; i < Orders.Num(); i++)
 			{
-				FFlareShipyardOrderSave& Order = Orders[i];
+				const FFlareShipyardOrderSave& Order = Orders[i];
 
 				if(Order.Company == PlayerCompany->GetIdentifier())
 				{
@@ -2120,6 +2551,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 					FFlareIncomingEvent ProductionEvent;
 					ProductionEvent.Text = ProductionText;
 					ProductionEvent.RemainingDuration = ProductionTime;
+					ProductionEvent.Identifier = FName(*("order-" + CompanyStation->GetImmatriculation().ToString() + "-" + FString::FromInt(i)));
 					IncomingEvents.Add(ProductionEvent);
 				}
 			}
@@ -2132,6 +2564,8 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 		FFlareSectorBattleState BattleState = Sector->GetSectorBattleState(PlayerCompany);
 		if(BattleState.InBattle)
 		{
+			FName BattleIdentifier = FName(*("battle-" + Sector->GetIdentifier().ToString()));
+
 			if(Sector == Game->GetPC()->GetPlayerFleet()->GetCurrentSector())
 			{
 				if (BattleState.InBattle && BattleState.InFight && BattleState.InActiveFight)
@@ -2140,6 +2574,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 					FFlareIncomingEvent LocalBattleEvent;
 					LocalBattleEvent.Text = LOCTEXT("LocalBattleFightEventTextFormat", "\u2022 <WarningText>Battle in progress here !</>");
 					LocalBattleEvent.RemainingDuration = -1;
+					LocalBattleEvent.Identifier = BattleIdentifier;
 					IncomingEvents.Add(LocalBattleEvent);
 				}
 				else
@@ -2149,6 +2584,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 													Sector->GetSectorBattleStateText(PlayerCompany),
 													 Sector->GetSectorName());
 					LocalBattleEvent.RemainingDuration = 0;
+					LocalBattleEvent.Identifier = BattleIdentifier;
 					IncomingEvents.Add(LocalBattleEvent);
 				}
 			}
@@ -2159,6 +2595,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 												Sector->GetSectorBattleStateText(PlayerCompany),
 												 Sector->GetSectorName());
 				RemoteBattleEvent.RemainingDuration = 0;
+				RemoteBattleEvent.Identifier = BattleIdentifier;
 				IncomingEvents.Add(RemoteBattleEvent);
 			}
 		}
@@ -2176,6 +2613,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 			RepairEvent.Text = FText::Format(LOCTEXT("RepairEventTextFormat", "\u2022 {0} being repaired ({1} left)"),
 				Fleet->GetFleetName(), UFlareGameTools::FormatDate(RepairDuration, 2));
 			RepairEvent.RemainingDuration = RepairDuration;
+			RepairEvent.Identifier = FName(*("repair-" + Fleet->GetIdentifier().ToString()));
 			IncomingEvents.Add(RepairEvent);
 		}
 
@@ -2185,6 +2623,7 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 			RefillEvent.Text = FText::Format(LOCTEXT("RefillEventTextFormat", "\u2022 {0} being refilled ({1} left)"),
 				Fleet->GetFleetName(), UFlareGameTools::FormatDate(RefillDuration, 2));;
 			RefillEvent.RemainingDuration = RefillDuration;
+			RefillEvent.Identifier = FName(*("refill-" + Fleet->GetIdentifier().ToString()));
 			IncomingEvents.Add(RefillEvent);
 		}
 	}
@@ -2194,7 +2633,26 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 	{
 		return (ip1.RemainingDuration < ip2.RemainingDuration);
 	});
-	return IncomingEvents;
+}
+
+const FFlareEconomySnapshot* UFlareWorld::GetEconomySnapshot()
+{
+	if (!EconomySnapshot.IsValid() || EconomySnapshot->Date != WorldData.Date)
+	{
+		UpdateEconomySnapshot();
+	}
+
+	return EconomySnapshot.Get();
+}
+
+FFlareResourceStatsCache& UFlareWorld::GetResourceStatsCache()
+{
+	if (!ResourceStatsCache.IsValid())
+	{
+		ResourceStatsCache = MakeShareable(new FFlareResourceStatsCache(this));
+	}
+
+	return *ResourceStatsCache;
 }
 
 int32 UFlareWorld::GetTotalWorldCombatPoint()
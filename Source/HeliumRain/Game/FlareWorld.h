@@ -4,6 +4,7 @@
 #include "Object.h"
 #include "FlareGameTypes.h"
 #include "FlareTravel.h"
+#include "FlareSimulationProfiler.h"
 #include "Planetarium/FlareSimulatedPlanetarium.h"
 #include "FlareWorld.generated.h"
 
@@ -18,6 +19,8 @@
 
 struct FFlareSectorSave;
 struct FFlareSectorDescription;
+struct FFlareEconomySnapshot;
+struct FFlareResourceStatsCache;
 
 class UFlareCompany;
 class UFlareFleet;
@@ -118,9 +121,15 @@ public:
 	/** Loading is done */
 	virtual void PostLoad();
 
-	/** Save the company to a save file */
+	/** Save the world to a save file. Only the objects that changed since the last save are rewritten */
 	virtual FFlareWorldSave* Save();
 
+	/** Get the number of objects rewritten by the last save */
+	inline int32 GetLastSaveRewriteCount() const
+	{
+		return LastSaveRewriteCount;
+	}
+
 	/** Spawn a company from save data */
 	virtual UFlareCompany* LoadCompany(const FFlareCompanySave& CompanyData);
 
@@ -129,6 +138,32 @@ public:
 
 	UFlareTravel* LoadTravel(const FFlareTravelSave& TravelData);
 
+
+	/*----------------------------------------------------
+		Identifier indices
+	----------------------------------------------------*/
+
+	/** Index a spacecraft by immatriculation, in the alive or destroyed index depending on its state */
+	void RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	/** Remove a spacecraft from the alive and destroyed indices */
+	void UnregisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	/** Index a fleet by identifier */
+	void RegisterFleet(UFlareFleet* Fleet);
+
+	/** Remove a fleet from the index */
+	void UnregisterFleet(UFlareFleet* Fleet);
+
+	/** Index a trade route by identifier */
+	void RegisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	/** Remove a trade route from the index */
+	void UnregisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	/** Compare the indices with the company and sector lists, logging every mismatch */
+	bool CheckIndices();
+
 	/*----------------------------------------------------
 		Gameplay
 	----------------------------------------------------*/
@@ -150,8 +185,20 @@ public:
 
 	void SimulatePeopleMoneyMigration();
 
-	/** Simulate world from now to the next event */
-	void FastForward();
+	/** Simulate up to DayCount days with notifications deferred, stopping when the incoming events change or a notification must be seen. Return the simulated day count */
+	int32 SimulateDays(int32 DayCount);
+
+	/** Get the phase timings of the last simulated day */
+	const FFlareSimulationTimings& GetLastSimulationTimings() const
+	{
+		return SimulationProfiler.GetLastDay();
+	}
+
+	/** Get the timings of the last simulated days */
+	FFlareSimulationProfiler& GetSimulationProfiler()
+	{
+		return SimulationProfiler;
+	}
 
 	UFlareTravel* StartTravel(UFlareFleet* TravelingFleet, UFlareSimulatedSector* DestinationSector, bool Force=false);
 
@@ -169,8 +216,38 @@ public:
 	/** Add a factory to world */
 	void AddFactory(UFlareFactory* Factory);
 
+	/** Get the precomputed travel duration between two world sectors, -1 if one of them is not a world sector */
+	int64 GetCachedTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel);
+
+	/** Rebuild the travel duration matrix on next use */
+	void InvalidateTravelDurations();
+
+	/** Update the diplomacy matrix after a hostility change between two companies */
+	void UpdateHostility(UFlareCompany* Company, UFlareCompany* TargetCompany);
+
+	/** Compute the economy snapshot shared by all companies for the current day */
+	void UpdateEconomySnapshot();
+
+	/** Run the read-only planning pass of all company AIs, in parallel */
+	void PlanCompanyAI();
+
 protected:
 
+	/** Check if the player has no controllable ship left */
+	bool IsPlayerFleetDisabled();
+
+	/** Player recovery, leaderboard and achievements checks */
+	void CheckPlayerState();
+
+	/** Compute the travel durations between all world sectors */
+	void UpdateTravelDurations();
+
+	/** Compute the diplomacy matrix between all companies */
+	void UpdateHostilities();
+
+	/** Build the list of incoming events from the travels, meteorites, shipyards, battles and fleets */
+	void UpdateIncomingEvents();
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -198,6 +275,43 @@ protected:
 
 	AFlareGame*                             Game;
 
+	// Travel durations between world sectors : one dense matrix for each travel technology tier
+	TArray<int64>                           TravelDurations;
+	bool                                    TravelDurationsValid;
+
+	// Incremental save
+	bool                                    SaveSnapshotValid;
+	int32                                   LastSaveRewriteCount;
+
+	// Diplomacy between companies : dense matrices of EFlareHostility values, indexed by company world index
+	TArray<uint8>                           Hostilities;
+	TArray<uint8>                           WarStates;
+
+	// Company-independent economy data for the day
+	TSharedPtr<FFlareEconomySnapshot>       EconomySnapshot;
+
+	// Resource stats shown by the menus
+	TSharedPtr<FFlareResourceStatsCache>    ResourceStatsCache;
+
+	// Identifier indices, kept up to date by the companies
+	TMap<FName, UFlareSimulatedSector*>     SectorIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> SpacecraftIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> DestroyedSpacecraftIndex;
+	TMap<FName, UFlareFleet*>               FleetIndex;
+	TMap<FName, UFlareTradeRoute*>          TradeRouteIndex;
+
+	// Incoming events of the player, versioned for the menus
+	TArray<FFlareIncomingEvent>             IncomingEvents;
+	bool                                    IncomingEventsValid;
+	int64                                   IncomingEventsDate;
+	int32                                   IncomingEventsVersion;
+
+	// Running SimulateDays
+	bool                                    BatchSimulation;
+
+	// Phase timings of the last simulated days
+	FFlareSimulationProfiler                SimulationProfiler;
+
 	bool WorldMoneyReferenceInit;
 
 public:
@@ -249,12 +363,14 @@ public:
 
 	UFlareSimulatedSector* FindSector(FName Identifier) const;
 
-	UFlareSimulatedSector* FindSectorBySpacecraft(FName SpacecraftIdentifier) const;
+	/** Get the sector of an alive spacecraft, by immatriculation */
+	UFlareSimulatedSector* FindSectorBySpacecraft(FName SpacecraftImmatriculation) const;
 
 	UFlareFleet* FindFleet(FName Identifier) const;
 
 	UFlareTradeRoute* FindTradeRoute(FName Identifier) const;
 
+	/** Find a spacecraft by immatriculation, alive ones first */
 	UFlareSimulatedSpacecraft* FindSpacecraft(FName ShipImmatriculation);
 
 	inline const TArray<UFlareCompany*>& GetCompanies() const
@@ -262,14 +378,48 @@ public:
 		return Companies;
 	}
 
+	/** Get the cached hostility of a company toward another one */
+	inline EFlareHostility::Type GetCachedHostility(int32 CompanyIndex, int32 TargetCompanyIndex) const
+	{
+		return (EFlareHostility::Type) Hostilities[CompanyIndex * Companies.Num() + TargetCompanyIndex];
+	}
+
+	/** Get the cached war state between two companies, hostile if at least one company is hostile */
+	inline EFlareHostility::Type GetCachedWarState(int32 CompanyIndex, int32 TargetCompanyIndex) const
+	{
+		return (EFlareHostility::Type) WarStates[CompanyIndex * Companies.Num() + TargetCompanyIndex];
+	}
+
 	int64 GetWorldMoney();
 
 	uint32 GetWorldPopulation();
 
-	TArray<FFlareIncomingEvent> GetIncomingEvents();
+	/** Get the incoming events of the player, sorted by remaining duration. The list is rebuilt when invalidated or when the day changes. */
+	const TArray<FFlareIncomingEvent>& GetIncomingEvents();
+
+	/** Get the sorted identifiers of the incoming events, to detect events that appear or resolve */
+	TArray<FName> GetIncomingEventIdentifiers();
+
+	/** Get a number that changes every time the incoming events list is rebuilt */
+	inline int32 GetIncomingEventsVersion() const
+	{
+		return IncomingEventsVersion;
+	}
+
+	/** Request a rebuild of the incoming events on the next access */
+	inline void InvalidateIncomingEvents()
+	{
+		IncomingEventsValid = false;
+	}
 
 	int32 GetTotalWorldCombatPoint();
 
 	TMap<IncomingKey, IncomingValue> GetIncomingPlayerEnemy();
 
+	/** Get the economy snapshot of the current day, computing it if needed */
+	const FFlareEconomySnapshot* GetEconomySnapshot();
+
+	/** Get the resource stats of the world and its sectors, for the menus */
+	FFlareResourceStatsCache& GetResourceStatsCache();
+
 };
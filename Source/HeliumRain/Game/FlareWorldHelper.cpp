@@ -4,23 +4,30 @@
 
 #include "../Data/FlareResourceCatalog.h"
 
+#include "../Economy/FlareCargoBay.h"
+
 #include "FlareGame.h"
 #include "FlareWorld.h"
 #include "FlareSectorHelper.h"
 #include "FlareSimulatedSector.h"
 #include "FlareScenarioTools.h"
+#include "FlareFleet.h"
 
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game)
+DECLARE_CYCLE_STAT(TEXT("WorldHelper ComputeSectorStats"), STAT_WorldHelper_ComputeSectorStats, STATGROUP_Flare);
+
+
+TArray<WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game)
 {
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+	int32 ResourceCount = Game->GetResourceCatalog()->Resources.Num();
 
 	// Init
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	WorldStats.Reserve(ResourceCount);
+	for(int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
 		WorldHelper::FlareResourceStats ResourceStats;
 		ResourceStats.Production = 0;
 		ResourceStats.Consumption = 0;
@@ -28,50 +35,171 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::C
 		ResourceStats.Stock = 0;
 		ResourceStats.Capacity = 0;
 
-		WorldStats.Add(Resource, ResourceStats);
+		WorldStats.Add(ResourceStats);
 	}
 
 	for (int SectorIndex = 0; SectorIndex < Game->GetGameWorld()->GetSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Game->GetGameWorld()->GetSectors()[SectorIndex];
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorStats;
-
-		SectorStats = SectorHelper::ComputeSectorResourceStats(Sector);
-
+		TArray<WorldHelper::FlareResourceStats> SectorStats = SectorHelper::ComputeSectorResourceStats(Sector);
 
-		for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+		for(int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 		{
-			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-
-			WorldHelper::FlareResourceStats& SectorResourceStats = SectorStats[Resource];
-			WorldHelper::FlareResourceStats& ResourceStats = WorldStats[Resource];
+			const WorldHelper::FlareResourceStats& SectorResourceStats = SectorStats[ResourceIndex];
+			WorldHelper::FlareResourceStats& ResourceStats = WorldStats[ResourceIndex];
 			ResourceStats.Production += SectorResourceStats.Production;
 			ResourceStats.Consumption += SectorResourceStats.Consumption;
 			ResourceStats.Balance += SectorResourceStats.Balance;
 			ResourceStats.Stock += SectorResourceStats.Stock;
 			ResourceStats.Capacity += SectorResourceStats.Capacity;
-
-			WorldStats.Add(Resource, ResourceStats);
 		}
 	}
 
 
 	// Balance
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	for(int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[ResourceIndex];
 
 		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
+	}
+
+	return WorldStats;
+}
+
+
+/*----------------------------------------------------
+	Resource stats cache
+----------------------------------------------------*/
+
+FFlareResourceStatsCache::FFlareResourceStatsCache(UFlareWorld* ParentWorld)
+	: World(ParentWorld)
+	, WorldStatsDate(-1)
+{
+}
+
+const TArray<WorldHelper::FlareResourceStats>& FFlareResourceStatsCache::GetSectorStats(UFlareSimulatedSector* Sector)
+{
+	int32 SectorIndex = Sector->GetWorldIndex();
+	if (SectorStatsDates.Num() <= SectorIndex)
+	{
+		SectorStats.SetNum(World->GetSectors().Num());
+		SectorStatsDates.Init(-1, World->GetSectors().Num());
+	}
+
+	if (SectorStatsDates[SectorIndex] != World->GetDate())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WorldHelper_ComputeSectorStats);
+
+		SectorStats[SectorIndex] = SectorHelper::ComputeSectorResourceStats(Sector);
+		SectorStatsDates[SectorIndex] = World->GetDate();
+	}
+
+	return SectorStats[SectorIndex];
+}
+
+const TArray<WorldHelper::FlareResourceStats>& FFlareResourceStatsCache::GetWorldStats()
+{
+	if (WorldStatsDate != World->GetDate())
+	{
+		int32 ResourceCount = World->GetGame()->GetResourceCatalog()->Resources.Num();
+		WorldStats.SetNumUninitialized(ResourceCount);
+		FMemory::Memzero(WorldStats.GetData(), ResourceCount * sizeof(WorldHelper::FlareResourceStats));
+
+		for (UFlareSimulatedSector* Sector : World->GetSectors())
+		{
+			const TArray<WorldHelper::FlareResourceStats>& Stats = GetSectorStats(Sector);
+
+			for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+			{
+				WorldStats[ResourceIndex].Production += Stats[ResourceIndex].Production;
+				WorldStats[ResourceIndex].Consumption += Stats[ResourceIndex].Consumption;
+				WorldStats[ResourceIndex].Stock += Stats[ResourceIndex].Stock;
+				WorldStats[ResourceIndex].Capacity += Stats[ResourceIndex].Capacity;
+			}
+		}
+
+		for (WorldHelper::FlareResourceStats& ResourceStats : WorldStats)
+		{
+			ResourceStats.Balance = ResourceStats.Production - ResourceStats.Consumption;
+		}
 
-		/*FLOGV("World stats for %s: Production=%f Consumption=%f Balance=%f Stock=%d",
-			  *Resource->Name.ToString(),
-			  ResourceStats->Production,
-			  ResourceStats->Consumption,
-			  ResourceStats->Balance,
-			  ResourceStats->Stock);*/
+		WorldStatsDate = World->GetDate();
 	}
 
 	return WorldStats;
 }
+
+void FFlareResourceStatsCache::Invalidate(UFlareSimulatedSector* Sector)
+{
+	if (Sector && SectorStatsDates.IsValidIndex(Sector->GetWorldIndex()))
+	{
+		SectorStatsDates[Sector->GetWorldIndex()] = -1;
+	}
+
+	if (Sector && Sector->GetWorldIndex() != INDEX_NONE)
+	{
+		if (SectorVersions.Num() <= Sector->GetWorldIndex())
+		{
+			SectorVersions.SetNumZeroed(World->GetSectors().Num());
+		}
+		SectorVersions[Sector->GetWorldIndex()]++;
+	}
+
+	WorldStatsDate = -1;
+}
+
+int32 FFlareResourceStatsCache::GetSectorVersion(UFlareSimulatedSector* Sector) const
+{
+	return (SectorVersions.IsValidIndex(Sector->GetWorldIndex()) ? SectorVersions[Sector->GetWorldIndex()] : 0);
+}
+
+
+/*----------------------------------------------------
+	Economy snapshot
+----------------------------------------------------*/
+
+void WorldHelper::ComputeEconomySnapshot(AFlareGame* Game, FFlareEconomySnapshot& Snapshot)
+{
+	UFlareWorld* GameWorld = Game->GetGameWorld();
+	UFlareResourceCatalog* ResourceCatalog = Game->GetResourceCatalog();
+
+	Snapshot.Date = GameWorld->GetDate();
+	Snapshot.WorldStats = ComputeWorldResourceStats(Game);
+	Snapshot.SectorSnapshots.SetNum(GameWorld->GetSectors().Num());
+
+	for (int SectorIndex = 0; SectorIndex < GameWorld->GetSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = GameWorld->GetSectors()[SectorIndex];
+		FFlareSectorEconomySnapshot& SectorSnapshot = Snapshot.SectorSnapshots[Sector->GetWorldIndex()];
+		SectorSnapshot.FleetSupplyNeeds.Empty();
+		SectorSnapshot.PeopleConsumption.Init(0, ResourceCatalog->Resources.Num());
+
+		// People consumption
+		for (int32 ResourceIndex = 0; ResourceIndex < ResourceCatalog->ConsumerResources.Num(); ResourceIndex++)
+		{
+			FFlareResourceDescription* Resource = &ResourceCatalog->ConsumerResources[ResourceIndex]->Data;
+			SectorSnapshot.PeopleConsumption[Resource->Index] = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+		}
+
+		// Fleet supply needs
+		for (int CompanyIndex = 0; CompanyIndex < GameWorld->GetCompanies().Num(); CompanyIndex++)
+		{
+			UFlareCompany* Company = GameWorld->GetCompanies()[CompanyIndex];
+
+			int32 NeededFS;
+			int32 TotalNeededFS;
+			int64 MaxDuration;
+			int32 NeededFSSum = 0;
+
+			SectorHelper::GetRefillFleetSupplyNeeds(Sector, Company, NeededFS, TotalNeededFS, MaxDuration);
+			NeededFSSum += TotalNeededFS;
+
+			SectorHelper::GetRepairFleetSupplyNeeds(Sector, Company, NeededFS, TotalNeededFS, MaxDuration);
+			NeededFSSum += TotalNeededFS;
+
+			SectorSnapshot.FleetSupplyNeeds.Add(Company, NeededFSSum);
+		}
+	}
+}
@@ -2,6 +2,8 @@
 #include "../Economy/FlareResource.h"
 #include "FlareWorld.h"
 
+struct FFlareEconomySnapshot;
+
 struct WorldHelper
 {
 	struct FlareResourceStats
@@ -13,10 +15,68 @@ struct WorldHelper
 		int32 Capacity;
 	};
 
-	static TMap<FFlareResourceDescription*, FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game);
+	/** Compute the world resource stats, indexed by resource catalog index */
+	static TArray<FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game);
+
+	/** Compute the company-independent economy data shared by all AI companies for a day */
+	static void ComputeEconomySnapshot(AFlareGame* Game, FFlareEconomySnapshot& Snapshot);
 
 
 private:
 
 
 };
+
+/** Resource stats of the world and its sectors, computed at most once per simulated day */
+struct FFlareResourceStatsCache
+{
+public:
+
+	FFlareResourceStatsCache(UFlareWorld* ParentWorld);
+
+	/** Get the resource stats of a sector, indexed by resource */
+	const TArray<WorldHelper::FlareResourceStats>& GetSectorStats(UFlareSimulatedSector* Sector);
+
+	/** Get the world resource stats, indexed by resource */
+	const TArray<WorldHelper::FlareResourceStats>& GetWorldStats();
+
+	/** Compute the stats of a sector and of the world again on the next request, after a change in the middle of a day */
+	void Invalidate(UFlareSimulatedSector* Sector);
+
+	/** Get a counter increased each time the sector is invalidated */
+	int32 GetSectorVersion(UFlareSimulatedSector* Sector) const;
+
+
+protected:
+
+	UFlareWorld* World;
+
+	// Stats and the date they were computed on, -1 when invalid. Sectors are indexed by world index.
+	TArray<TArray<WorldHelper::FlareResourceStats>> SectorStats;
+	TArray<int64> SectorStatsDates;
+	TArray<int32> SectorVersions;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+	int64 WorldStatsDate;
+};
+
+/** Company-independent economy data for a sector */
+struct FFlareSectorEconomySnapshot
+{
+	/** Consumer resources bought by the population each day, indexed by resource */
+	TArray<int32> PeopleConsumption;
+
+	/** Fleet supply each company needs to repair and refill its ships in this sector */
+	TMap<UFlareCompany*, int32> FleetSupplyNeeds;
+};
+
+/** Immutable economy data computed once per simulated day */
+struct FFlareEconomySnapshot
+{
+	int64 Date;
+
+	/** World resource stats, indexed by resource */
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+
+	/** Sector data, indexed by sector world index */
+	TArray<FFlareSectorEconomySnapshot> SectorSnapshots;
+};
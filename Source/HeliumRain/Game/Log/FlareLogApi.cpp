@@ -11,6 +11,30 @@
 #include "../../Spacecrafts/FlareSimulatedSpacecraft.h"
 #include "../Save/FlareSaveWriter.h"
 
+
+/** Set the sector and company of a spacecraft as message context */
+static void SetSpacecraftContext(FlareLogMessage& Message, UFlareSimulatedSpacecraft* Spacecraft)
+{
+	if (Spacecraft->GetCurrentSector())
+	{
+		Message.Sector = Spacecraft->GetCurrentSector()->GetIdentifier().ToString();
+	}
+	Message.Company = Spacecraft->GetCompany()->GetShortName().ToString();
+}
+
+/** Get the name of a damage type, without looking up the enum for each message */
+static const FString& GetDamageTypeName(EFlareDamage::Type DamageType)
+{
+	static TMap<int32, FString> DamageTypeNames;
+
+	FString* Name = DamageTypeNames.Find(DamageType);
+	if (!Name)
+	{
+		Name = &DamageTypeNames.Add(DamageType, UFlareSaveWriter::FormatEnum<EFlareDamage::Type>("EFlareDamage", DamageType));
+	}
+	return *Name;
+}
+
 // Game log api
 
 void GameLog::GameLoaded()
@@ -54,6 +78,8 @@ void GameLog::AIConstructionStart(UFlareCompany* Company,
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Game;
 	Message.Event = EFlareLogEvent::AI_CONSTRUCTION_STARTED;
+	Message.Sector = ConstructionSector->GetIdentifier().ToString();
+	Message.Company = Company->GetShortName().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -89,6 +115,7 @@ void GameLog::UnlockResearch(UFlareCompany* Company,
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Game;
 	Message.Event = EFlareLogEvent::COMPANY_UNLOCK_RESEARCH;
+	Message.Company = Company->GetShortName().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -113,6 +140,7 @@ void CombatLog::SectorActivated(UFlareSimulatedSector* Sector)
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SECTOR_ACTIVATED;
+	Message.Sector = Sector->GetIdentifier().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -129,6 +157,7 @@ void CombatLog::SectorDeactivated(UFlareSimulatedSector* Sector)
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SECTOR_DEACTIVATED;
+	Message.Sector = Sector->GetIdentifier().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -145,6 +174,7 @@ void CombatLog::AutomaticBattleStarted(UFlareSimulatedSector* Sector)
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::AUTOMATIC_BATTLE_STARTED;
+	Message.Sector = Sector->GetIdentifier().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -161,6 +191,7 @@ void CombatLog::AutomaticBattleEnded(UFlareSimulatedSector* Sector)
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::AUTOMATIC_BATTLE_ENDED;
+	Message.Sector = Sector->GetIdentifier().ToString();
 
 	{
 		FlareLogMessageParam Param;
@@ -177,6 +208,7 @@ void CombatLog::BombDropped(AFlareBomb *Bomb)
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::BOMB_DROPPED;
+	SetSpacecraftContext(Message, Bomb->GetFiringSpacecraft()->GetParent());
 
 	{
 		FlareLogMessageParam Param;
@@ -230,6 +262,7 @@ void CombatLog::SpacecraftDamaged(UFlareSimulatedSpacecraft* Spacecraft, float E
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SPACECRAFT_DAMAGED;
+	SetSpacecraftContext(Message, Spacecraft);
 
 	{
 		FlareLogMessageParam Param;
@@ -241,7 +274,7 @@ void CombatLog::SpacecraftDamaged(UFlareSimulatedSpacecraft* Spacecraft, float E
 	{
 		FlareLogMessageParam Param;
 		Param.Type = EFlareLogParam::String;
-		Param.StringValue = UFlareSaveWriter::FormatEnum<EFlareDamage::Type>("EFlareDamage", DamageType);
+		Param.StringValue = GetDamageTypeName(DamageType);
 		Message.Params.Add(Param);
 	}
 
@@ -288,6 +321,7 @@ void CombatLog::SpacecraftComponentDamaged(UFlareSimulatedSpacecraft* Spacecraft
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SPACECRAFT_COMPONENT_DAMAGED;
+	SetSpacecraftContext(Message, Spacecraft);
 
 	{
 		FlareLogMessageParam Param;
@@ -327,7 +361,7 @@ void CombatLog::SpacecraftComponentDamaged(UFlareSimulatedSpacecraft* Spacecraft
 	{
 		FlareLogMessageParam Param;
 		Param.Type = EFlareLogParam::String;
-		Param.StringValue = UFlareSaveWriter::FormatEnum<EFlareDamage::Type>("EFlareDamage", DamageType);
+		Param.StringValue = GetDamageTypeName(DamageType);
 		Message.Params.Add(Param);
 	}
 
@@ -353,6 +387,7 @@ void CombatLog::SpacecraftHarpooned(UFlareSimulatedSpacecraft* Spacecraft, UFlar
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SPACECRAFT_HARPOONED;
+	SetSpacecraftContext(Message, Spacecraft);
 
 	{
 		FlareLogMessageParam Param;
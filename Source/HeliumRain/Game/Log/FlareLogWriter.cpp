@@ -12,6 +12,16 @@ FFlareLogWriter* FFlareLogWriter::Runnable = NULL;
 
 static int ThreadIndex = 0;
 
+#define LOG_FILE_MAGIC          0x474F4C46 // "FLOG"
+#define LOG_FILE_VERSION        1
+
+#define LOG_RECORD_STRING       0
+#define LOG_RECORD_MESSAGE      1
+
+// Buffered records are written when the buffer is full or when no message came for a while
+#define LOG_BUFFER_SIZE         65536
+#define LOG_FLUSH_DELAY_MS      1000
+
 FFlareLogWriter::FFlareLogWriter(FName UUID)
 	: StopTaskCounter(0),
 	  GameUUID(UUID)
@@ -19,9 +29,6 @@ FFlareLogWriter::FFlareLogWriter(FName UUID)
 {
 	FString Name = TEXT("FFlareLogWriter-") + FString::FromInt(ThreadIndex);
 
-	GameLogFile = NULL;
-	CombatLogFile = NULL;
-
 	Thread = FRunnableThread::Create(this, *Name, 0, TPri_BelowNormal); //windows default = 8mb for thread, could specify more
 	ThreadIndex++;
 }
@@ -58,13 +65,26 @@ uint32 FFlareLogWriter::Run()
 	//		and not yet finished finding Prime Numbers
 	while (StopTaskCounter.GetValue() == 0)
 	{
-		NewMessageEvent->Wait();
+		bool NewMessages = NewMessageEvent->Wait(LOG_FLUSH_DELAY_MS);
 
 		FlareLogMessage Message;
 		while (MessageQueue.Dequeue(Message))
 		{
 			WriteMessage(Message);
 		}
+
+		if (!NewMessages)
+		{
+			FlushLogFile(GameLogFile);
+			FlushLogFile(CombatLogFile);
+		}
+	}
+
+	// Messages pushed while stopping
+	FlareLogMessage Message;
+	while (MessageQueue.Dequeue(Message))
+	{
+		WriteMessage(Message);
 	}
 
 	CloseLogFiles();
@@ -115,114 +135,174 @@ void FFlareLogWriter::Shutdown()
 
 void FFlareLogWriter::InitLogFiles()
 {
-	if(!GameLogFile)
+	if(!GameLogFile.Handle)
 	{
-		GameLogFile = InitLogFile("Game");
+		InitLogFile(GameLogFile, "Game");
 	}
 
-	if(!CombatLogFile)
+	if(!CombatLogFile.Handle)
 	{
-		CombatLogFile = InitLogFile("Combat");
+		InitLogFile(CombatLogFile, "Combat");
 	}
 }
 
 void FFlareLogWriter::CloseLogFiles()
 {
-	if (GameLogFile)
+	FlushLogFile(GameLogFile);
+	FlushLogFile(CombatLogFile);
+
+	if (GameLogFile.Handle)
 	{
-		delete GameLogFile;
-		GameLogFile = NULL;
+		delete GameLogFile.Handle;
+		GameLogFile.Handle = NULL;
 	}
 
-	if (CombatLogFile)
+	if (CombatLogFile.Handle)
 	{
-		delete CombatLogFile;
-		CombatLogFile = NULL;
+		delete CombatLogFile.Handle;
+		CombatLogFile.Handle = NULL;
 	}
 }
 
-IFileHandle* FFlareLogWriter::InitLogFile(FString BaseName)
+void FFlareLogWriter::InitLogFile(FFlareLogFile& File, FString BaseName)
 {
-	FString FileName = FString::Printf(TEXT("%s/SaveGames/%s-%s.log"), *FPaths::GameSavedDir(), *BaseName, *GameUUID.ToString());
+	FString FileName = FString::Printf(TEXT("%s/SaveGames/%s-%s.flog"), *FPaths::GameSavedDir(), *BaseName, *GameUUID.ToString());
 
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
 	FLOGV("Init log file '%s'", *FileName);
-	IFileHandle* FileHandle = PlatformFile.OpenWrite(*FileName, true);
+	File.Handle = PlatformFile.OpenWrite(*FileName, true);
+	File.Buffer.Reserve(LOG_BUFFER_SIZE);
 
-	if (!FileHandle)
+	if (!File.Handle)
 	{
 		FLOGV("Fail to init log file '%s' for base name '%s'", *FileName, *BaseName);
 	}
 
-	return FileHandle;
+	// Logs of a loaded game are appended to the existing file : string ids are then defined again
+	else if (File.Handle->Size() == 0)
+	{
+		WriteValue<uint32>(File, LOG_FILE_MAGIC);
+		WriteValue<uint32>(File, LOG_FILE_VERSION);
+	}
 }
 
-void FFlareLogWriter::WriteLine(IFileHandle* FileHandle, FString& Line)
+void FFlareLogWriter::FlushLogFile(FFlareLogFile& File)
 {
-	FileHandle->Write((const uint8*)TCHAR_TO_ANSI(*Line), Line.Len());
+	if (File.Handle && File.Buffer.Num() > 0)
+	{
+		File.Handle->Write(File.Buffer.GetData(), File.Buffer.Num());
+		File.Handle->Flush();
+	}
+
+	File.Buffer.Reset();
+}
+
+uint32 FFlareLogWriter::InternString(FFlareLogFile& File, const FString& Value)
+{
+	if (Value.IsEmpty())
+	{
+		return 0;
+	}
+
+	uint32* ExistingId = File.Strings.Find(Value);
+	if (ExistingId)
+	{
+		return *ExistingId;
+	}
+
+	// New string
+	uint32 Id = File.Strings.Num() + 1;
+	File.Strings.Add(Value, Id);
+
+	FTCHARToUTF8 Converter(*Value);
+	uint16 Length = FMath::Min(Converter.Length(), (int32) MAX_uint16);
+
+	WriteValue<uint8>(File, LOG_RECORD_STRING);
+	WriteValue<uint32>(File, Id);
+	WriteValue<uint16>(File, Length);
+	File.Buffer.Append(reinterpret_cast<const uint8*>(Converter.Get()), Length);
+
+	return Id;
 }
 
 void FFlareLogWriter::WriteMessage(FlareLogMessage& Message)
 {
-	FString MessageString = FormatMessage(Message);
+	FFlareLogFile* File = NULL;
 
 	switch (Message.Target) {
 	case EFlareLogTarget::Game:
-		if (GameLogFile)
-		{
-			WriteLine(GameLogFile, MessageString);
-		}
-	break;
+		File = &GameLogFile;
+		break;
 	case EFlareLogTarget::Combat:
-		if (CombatLogFile)
-		{
-			WriteLine(CombatLogFile, MessageString);
-		}
+		File = &CombatLogFile;
 		break;
-
 	default:
 		break;
 	}
-}
 
-FString FFlareLogWriter::FormatMessage(FlareLogMessage& Message)
-{
+	if (!File || !File->Handle)
+	{
+		return;
+	}
 
-	FString MessageString = FString::Printf(
-				TEXT("%s %s"),
-				*Message.Date.ToString(TEXT("%Y-%m-%dT%H:%M:%S.%s")),
-				*UFlareSaveWriter::FormatEnum<EFlareLogEvent::Type>("EFlareLogEvent", Message.Event));
+	// Strings are defined before the message using them
+	uint32* EventId = File->EventStrings.Find(Message.Event);
+	if (!EventId)
+	{
+		uint32 NewEventId = InternString(*File, UFlareSaveWriter::FormatEnum<EFlareLogEvent::Type>("EFlareLogEvent", Message.Event));
+		EventId = &File->EventStrings.Add(Message.Event, NewEventId);
+	}
 
-	for(int32 ParamIndex = 0; ParamIndex < Message.Params.Num(); ParamIndex++)
+	TArray<uint32, TInlineAllocator<16>> ParamStrings;
+	for (FlareLogMessageParam& Param : Message.Params)
 	{
-		MessageString += "," + FormatParam(&Message.Params[ParamIndex]);
+		ParamStrings.Add(Param.Type == EFlareLogParam::String ? InternString(*File, Param.StringValue) : 0);
 	}
 
-	MessageString += "\n";
-	return MessageString;
-}
+	uint32 EventString = *EventId;
+	uint32 SectorString = InternString(*File, Message.Sector);
+	uint32 CompanyString = InternString(*File, Message.Company);
 
-FString FFlareLogWriter::FormatParam(FlareLogMessageParam* Param)
-{
-	switch (Param->Type) {
-	case EFlareLogParam::String:
-		return "\""+Param->StringValue+"\"";
-		break;
-	case EFlareLogParam::Integer:
-		return UFlareSaveWriter::FormatInt64(Param->IntValue);
-		break;
-	case EFlareLogParam::Float:
-		return  FString::Printf(TEXT("%f"), Param->FloatValue);
-		break;
-	case EFlareLogParam::Vector3:
-		return "("+UFlareSaveWriter::FormatVector(Param->Vector3Value)+")";
-		break;
-	default:
-		FLOGV("Invalid log param type %d", (Param->Type + 0));
-		break;
+	// Message header
+	WriteValue<uint8>(*File, LOG_RECORD_MESSAGE);
+	WriteValue<int64>(*File, Message.Date.GetTicks());
+	WriteValue<uint32>(*File, EventString);
+	WriteValue<uint32>(*File, SectorString);
+	WriteValue<uint32>(*File, CompanyString);
+	WriteValue<uint8>(*File, FMath::Min(Message.Params.Num(), (int32) MAX_uint8));
+
+	// Params
+	for (int32 ParamIndex = 0; ParamIndex < Message.Params.Num() && ParamIndex < MAX_uint8; ParamIndex++)
+	{
+		FlareLogMessageParam& Param = Message.Params[ParamIndex];
+		WriteValue<uint8>(*File, Param.Type);
+
+		switch (Param.Type) {
+		case EFlareLogParam::String:
+			WriteValue<uint32>(*File, ParamStrings[ParamIndex]);
+			break;
+		case EFlareLogParam::Integer:
+			WriteValue<int64>(*File, Param.IntValue);
+			break;
+		case EFlareLogParam::Float:
+			WriteValue<float>(*File, Param.FloatValue);
+			break;
+		case EFlareLogParam::Vector3:
+			WriteValue<float>(*File, Param.Vector3Value.X);
+			WriteValue<float>(*File, Param.Vector3Value.Y);
+			WriteValue<float>(*File, Param.Vector3Value.Z);
+			break;
+		default:
+			FLOGV("Invalid log param type %d", (Param.Type + 0));
+			break;
+		}
+	}
+
+	if (File->Buffer.Num() >= LOG_BUFFER_SIZE)
+	{
+		FlushLogFile(*File);
 	}
-	return "";
 }
 
 void FFlareLogWriter::PushMessage(FlareLogMessage& Message)
@@ -65,6 +65,31 @@ struct FlareLogMessage
 	EFlareLogTarget::Type Target;
 	EFlareLogEvent::Type Event;
 	TArray<FlareLogMessageParam> Params;
+
+	/** Context used to filter the log, empty if not relevant */
+	FString Sector;
+	FString Company;
+};
+
+/**
+ * Binary log file, written by the log thread.
+ *
+ * File    : "FLOG" magic, uint32 version, then records
+ * Record  : uint8 record type, then the record
+ * String  : uint32 id, uint16 length, UTF-8 characters. Ids start at 1, 0 is the empty string
+ * Message : int64 date ticks, uint32 event string, uint32 sector string, uint32 company string, uint8 param count, then params
+ * Param   : uint8 type, then uint32 string id, int64, float or 3 floats
+ */
+struct FFlareLogFile
+{
+	IFileHandle*                     Handle;
+	TArray<uint8>                    Buffer;
+	TMap<FString, uint32>            Strings;
+	TMap<int32, uint32>              EventStrings;
+
+	FFlareLogFile()
+		: Handle(NULL)
+	{}
 };
 
 
@@ -85,22 +110,27 @@ class FFlareLogWriter : public FRunnable
 
 	void CloseLogFiles();
 
-	IFileHandle* InitLogFile(FString BaseName);
+	void InitLogFile(FFlareLogFile& File, FString BaseName);
 
-	void WriteLine(IFileHandle* FileHandle, FString& Line);
+	/** Write the buffered records to the disk */
+	void FlushLogFile(FFlareLogFile& File);
 
 	void WriteMessage(FlareLogMessage& Message);
 
-	FString FormatMessage(FlareLogMessage& Message);
+	/** Get the id of a string, adding it to the file string table if needed */
+	uint32 InternString(FFlareLogFile& File, const FString& Value);
 
-	FString FormatParam(FlareLogMessageParam* Param);
+	template <typename T>
+	inline void WriteValue(FFlareLogFile& File, T Value)
+	{
+		File.Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
 
 private:
-	int32					PrimesFoundCount;
 	FEvent*					NewMessageEvent;
 	TQueue<FlareLogMessage>	MessageQueue;
-	IFileHandle*			GameLogFile;
-	IFileHandle*			CombatLogFile;
+	FFlareLogFile			GameLogFile;
+	FFlareLogFile			CombatLogFile;
 	FName					GameUUID;
 
 public:
@@ -6,6 +6,114 @@
 #include "FlareSaveReaderV1.h"
 #include "../FlareGame.h"
 
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Compression.h"
+
+
+/*----------------------------------------------------
+	Binary header
+----------------------------------------------------*/
+
+void FFlareBinarySaveHeader::Init(UFlareSaveGame* SaveData)
+{
+	Magic = FLARE_BINARY_SAVE_MAGIC;
+	FormatVersion = FLARE_BINARY_SAVE_VERSION;
+	UE4Version = GPackageFileUE4Version;
+	LicenseeUE4Version = GPackageFileLicenseeUE4Version;
+	EngineVersion = FEngineVersion::Current();
+	CustomVersions = FCustomVersionContainer::GetRegistered();
+	Metadata.Init(SaveData, FLARE_BINARY_SAVE_VERSION);
+}
+
+FArchive& operator<<(FArchive& Ar, FFlareBinarySaveHeader& Header)
+{
+	Ar << Header.Magic;
+	Ar << Header.FormatVersion;
+
+	// Don't read anything else from a foreign file
+	if (Ar.IsLoading() && Header.Magic != FLARE_BINARY_SAVE_MAGIC)
+	{
+		return Ar;
+	}
+
+	Ar << Header.UE4Version;
+	Ar << Header.LicenseeUE4Version;
+	Ar << Header.EngineVersion;
+	Header.CustomVersions.Serialize(Ar);
+
+	if (Header.FormatVersion >= FLARE_BINARY_SAVE_VERSION_METADATA)
+	{
+		Ar << Header.Metadata;
+	}
+
+	return Ar;
+}
+
+
+/*----------------------------------------------------
+	Metadata
+----------------------------------------------------*/
+
+void FFlareSaveMetadata::Init(UFlareSaveGame* SaveData, int32 SaveFormatVersion)
+{
+	const FFlareCompanyDescription* Desc = &SaveData->PlayerCompanyDescription;
+
+	FormatVersion = SaveFormatVersion;
+	UUID = SaveData->PlayerData.UUID;
+	CompanyIdentifier = SaveData->PlayerData.CompanyIdentifier;
+	CompanyName = Desc->Name;
+	CompanyValue = 0;
+	CompanyShipCount = 0;
+	Date = SaveData->WorldData.Date;
+	PlayerEmblemIndex = SaveData->PlayerData.PlayerEmblemIndex;
+	BasePaintColor = Desc->CustomizationBasePaintColor;
+	PaintColor = Desc->CustomizationPaintColor;
+	OverlayColor = Desc->CustomizationOverlayColor;
+	LightColor = Desc->CustomizationLightColor;
+
+	for (const FFlareCompanySave& Company : SaveData->WorldData.CompanyData)
+	{
+		if (Company.Identifier == CompanyIdentifier)
+		{
+			CompanyValue = Company.CompanyValue;
+			CompanyShipCount = Company.ShipData.Num();
+			break;
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FFlareSaveMetadata& Metadata)
+{
+	// Names and texts are stored as strings, the header isn't read through a name-aware archive
+	FString UUID = Metadata.UUID.ToString();
+	FString CompanyIdentifier = Metadata.CompanyIdentifier.ToString();
+	FString CompanyName = Metadata.CompanyName.ToString();
+
+	Ar << Metadata.FormatVersion;
+	Ar << UUID;
+	Ar << CompanyIdentifier;
+	Ar << CompanyName;
+	Ar << Metadata.CompanyValue;
+	Ar << Metadata.CompanyShipCount;
+	Ar << Metadata.Date;
+	Ar << Metadata.PlayerEmblemIndex;
+	Ar << Metadata.BasePaintColor;
+	Ar << Metadata.PaintColor;
+	Ar << Metadata.OverlayColor;
+	Ar << Metadata.LightColor;
+
+	if (Ar.IsLoading())
+	{
+		Metadata.UUID = FName(*UUID);
+		Metadata.CompanyIdentifier = FName(*CompanyIdentifier);
+		Metadata.CompanyName = FText::FromString(CompanyName);
+	}
+
+	return Ar;
+}
+
 
 /*----------------------------------------------------
 	Constructor
@@ -14,6 +122,8 @@
 UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	SaveFormat = EFlareSaveFormat::Binary;
+	SaveWriter = CreateDefaultSubobject<UFlareSaveWriter>(TEXT("SaveWriter"));
 }
 
 /*----------------------------------------------------
@@ -23,7 +133,8 @@ UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectIniti
 
 bool UFlareSaveGameSystem::DoesSaveGameExist(const FString SaveName)
 {
-	return IFileManager::Get().FileSize(*GetSaveGamePath(SaveName)) >= 0;
+	return IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName)) >= 0;
 }
 
 bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData)
@@ -32,7 +143,111 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 	SaveLock.Lock();
 	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s", *SaveName);
 
-	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
+	ret = WriteGame(SaveName, SaveData, SaveFormat);
+
+	SaveLock.Unlock();
+
+	SaveListLock.Lock();
+	SaveList.Remove(SaveData);
+	SaveListLock.Unlock();
+
+	return ret;
+}
+
+UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
+{
+	FLOGV("UFlareSaveGameSystem::LoadGame SaveName=%s", *SaveName);
+
+	// Binary saves are always the most recent ones
+	if (IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0)
+	{
+		return LoadGameBinary(SaveName);
+	}
+	else
+	{
+		return LoadGameJson(SaveName);
+	}
+}
+
+bool UFlareSaveGameSystem::LoadMetadata(const FString SaveName, FFlareSaveMetadata& Metadata)
+{
+	if (IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0)
+	{
+		return LoadMetadataBinary(SaveName, Metadata);
+	}
+	else
+	{
+		return LoadMetadataJson(SaveName, Metadata);
+	}
+}
+
+bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+{
+	bool Deleted = false;
+	Deleted |= IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	Deleted |= IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
+	return Deleted;
+}
+
+
+void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
+{
+	SaveListLock.Lock();
+	SaveList.Add(SaveData);
+	SaveListLock.Unlock();
+}
+
+bool UFlareSaveGameSystem::ConvertGame(const FString SaveName, EFlareSaveFormat::Type TargetFormat)
+{
+	FLOGV("UFlareSaveGameSystem::ConvertGame SaveName=%s TargetFormat=%d", *SaveName, (int32) TargetFormat);
+
+	UFlareSaveGame* SaveData = LoadGame(SaveName);
+	if (!SaveData)
+	{
+		FLOGV("UFlareSaveGameSystem::ConvertGame : can't read save '%s'", *SaveName);
+		return false;
+	}
+
+	SaveLock.Lock();
+	bool ret = WriteGame(SaveName, SaveData, TargetFormat);
+	SaveLock.Unlock();
+
+	return ret;
+}
+
+
+/*----------------------------------------------------
+	Formats
+----------------------------------------------------*/
+
+bool UFlareSaveGameSystem::WriteGame(const FString SaveName, UFlareSaveGame* SaveData, EFlareSaveFormat::Type Format)
+{
+	bool ret = false;
+
+	if (Format == EFlareSaveFormat::Binary)
+	{
+		ret = SaveGameBinary(SaveName, SaveData);
+		if (ret)
+		{
+			IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
+		}
+	}
+	else
+	{
+		ret = SaveGameJson(SaveName, SaveData);
+		if (ret)
+		{
+			IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+		}
+	}
+
+	return ret;
+}
+
+bool UFlareSaveGameSystem::SaveGameJson(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	bool ret = false;
+
 	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveGame(SaveData);
 
 	// Save the json object
@@ -44,8 +259,10 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 	{
 		JsonWriter->Close();
 
-		ret = FFileHelper::SaveStringToFile(FileContents, *GetSaveGamePath(SaveName));
-		FLOG("UFlareSaveGameSystem::SaveGame : Save done");
+		FString TempFileName = GetTemporarySaveGamePath(GetSaveGamePath(SaveName));
+		ret = FFileHelper::SaveStringToFile(FileContents, *TempFileName);
+		ret = ret && CommitSaveFile(TempFileName, GetSaveGamePath(SaveName));
+		FLOG("UFlareSaveGameSystem::SaveGameJson : Save done");
 	}
 	else
 	{
@@ -53,32 +270,196 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 		ret = false;
 	}
 
-	SaveLock.Unlock();
+	return ret;
+}
 
-	SaveListLock.Lock();
-	SaveList.Remove(SaveData);
-	SaveListLock.Unlock();
+bool UFlareSaveGameSystem::SaveGameBinary(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	// Properties are tagged by name, so that added or removed fields don't break older saves
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload, true);
+	FObjectAndNameAsStringProxyArchive Ar(PayloadWriter, false);
+	SaveData->Serialize(Ar);
+
+	// Compress the payload
+	int32 UncompressedSize = Payload.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, UncompressedSize);
+	TArray<uint8> CompressedPayload;
+	CompressedPayload.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedPayload.GetData(), CompressedSize, Payload.GetData(), UncompressedSize))
+	{
+		FLOGV("Fail to compress save %s", *SaveName);
+		return false;
+	}
+	CompressedPayload.SetNum(CompressedSize, false);
+
+	// Write the file
+	FString TempFileName = GetTemporarySaveGamePath(GetBinarySaveGamePath(SaveName));
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFileName));
+	if (!FileWriter)
+	{
+		FLOGV("Fail to open save '%s' for writing", *TempFileName);
+		return false;
+	}
+
+	FFlareBinarySaveHeader Header;
+	Header.Init(SaveData);
+	*FileWriter << Header;
+	*FileWriter << UncompressedSize;
+	*FileWriter << CompressedPayload;
+
+	bool ret = !FileWriter->IsError();
+	ret &= FileWriter->Close();
+	FileWriter.Reset();
+
+	ret = ret && CommitSaveFile(TempFileName, GetBinarySaveGamePath(SaveName));
+
+	if (ret)
+	{
+		FLOGV("UFlareSaveGameSystem::SaveGameBinary : Save done (%d bytes, %d compressed)", UncompressedSize, CompressedSize);
+	}
+	else
+	{
+		FLOGV("Fail to write save %s", *SaveName);
+	}
 
 	return ret;
 }
 
-UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
+bool UFlareSaveGameSystem::CommitSaveFile(const FString TempFileName, const FString FileName)
 {
-	FLOGV("UFlareSaveGameSystem::LoadGame SaveName=%s", *SaveName);
+	if (!IFileManager::Get().Move(*FileName, *TempFileName, true))
+	{
+		FLOGV("Fail to replace save '%s'", *FileName);
+		IFileManager::Get().Delete(*TempFileName, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool UFlareSaveGameSystem::LoadMetadataBinary(const FString SaveName, FFlareSaveMetadata& Metadata)
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*GetBinarySaveGamePath(SaveName)));
+	if (!FileReader)
+	{
+		return false;
+	}
+
+	FFlareBinarySaveHeader Header;
+	*FileReader << Header;
+
+	if (FileReader->IsError() || Header.Magic != FLARE_BINARY_SAVE_MAGIC
+		|| Header.FormatVersion < FLARE_BINARY_SAVE_VERSION_METADATA || Header.FormatVersion > FLARE_BINARY_SAVE_VERSION)
+	{
+		return false;
+	}
+
+	Metadata = Header.Metadata;
+	return true;
+}
+
+bool UFlareSaveGameSystem::LoadMetadataJson(const FString SaveName, FFlareSaveMetadata& Metadata)
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*GetSaveGamePath(SaveName)));
+	if (!FileReader)
+	{
+		return false;
+	}
+
+	// Only read the start of the file, the metadata block is small and written first
+	int64 ReadSize = FMath::Min(FileReader->TotalSize(), (int64) FLARE_JSON_SAVE_METADATA_READ_SIZE);
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(ReadSize);
+	FileReader->Serialize(Buffer.GetData(), ReadSize);
+	if (FileReader->IsError())
+	{
+		return false;
+	}
+
+	// Don't split a UTF-16 character
+	if (ReadSize < FileReader->TotalSize())
+	{
+		ReadSize &= ~1;
+	}
+
+	FString SaveString;
+	FFileHelper::BufferToString(SaveString, Buffer.GetData(), ReadSize);
+
+	// Stream the tokens until the metadata block, which is written first, and stop there
+	TSharedRef< TJsonReader<> > Reader = TJsonReaderFactory<>::Create(SaveString);
+	TSharedPtr<FJsonObject> MetadataObject = MakeShareable(new FJsonObject());
+	EJsonNotation Notation;
+	int32 Depth = 0;
+	bool InMetadata = false;
+	bool MetadataFound = false;
+
+	while (!MetadataFound && Reader->ReadNext(Notation))
+	{
+		switch (Notation)
+		{
+			case EJsonNotation::ObjectStart:
+			case EJsonNotation::ArrayStart:
+				Depth++;
+				InMetadata = (Depth == 2 && Notation == EJsonNotation::ObjectStart && Reader->GetIdentifier() == TEXT("Metadata"));
+
+				// Metadata is always before the game data
+				if (Depth == 2 && !InMetadata)
+				{
+					return false;
+				}
+				break;
+
+			case EJsonNotation::ObjectEnd:
+			case EJsonNotation::ArrayEnd:
+				Depth--;
+				MetadataFound = InMetadata;
+				break;
+
+			case EJsonNotation::String:
+				if (InMetadata)
+				{
+					MetadataObject->SetStringField(Reader->GetIdentifier(), Reader->GetValueAsString());
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
 
+	if (MetadataFound)
+	{
+		UFlareSaveReaderV1* SaveReader = NewObject<UFlareSaveReaderV1>(this, UFlareSaveReaderV1::StaticClass());
+		SaveReader->LoadMetadata(MetadataObject, &Metadata);
+	}
+
+	return MetadataFound;
+}
+
+UFlareSaveGame* UFlareSaveGameSystem::LoadGameJson(const FString SaveName)
+{
 	UFlareSaveGame *SaveGame = NULL;
+	double StartTs = FPlatformTime::Seconds();
 
 	// Read the saveto a string
 	FString SaveString;
 	if(FFileHelper::LoadFileToString(SaveString, *GetSaveGamePath(SaveName)))
 	{
+		double ReadTs = FPlatformTime::Seconds();
+
 		// Deserialize a JSON object from the string
 		TSharedPtr< FJsonObject > Object;
 		TSharedRef< TJsonReader<> > Reader = TJsonReaderFactory<>::Create(SaveString);
 		if(FJsonSerializer::Deserialize(Reader, Object) && Object.IsValid())
 		{
+			double DeserializeTs = FPlatformTime::Seconds();
+
 			UFlareSaveReaderV1* SaveReader = NewObject<UFlareSaveReaderV1>(this, UFlareSaveReaderV1::StaticClass());
 			SaveGame = SaveReader->LoadGame(Object);
+
+			FLOGV("UFlareSaveGameSystem::LoadGameJson : read %.2fms, JSON %.2fms, save data %.2fms",
+				(ReadTs - StartTs) * 1000, (DeserializeTs - ReadTs) * 1000, (FPlatformTime::Seconds() - DeserializeTs) * 1000);
 		}
 		else
 		{
@@ -93,17 +474,87 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 	return SaveGame;
 }
 
-bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+UFlareSaveGame* UFlareSaveGameSystem::LoadGameBinary(const FString SaveName)
 {
-	return IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
-}
+	double StartTs = FPlatformTime::Seconds();
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*GetBinarySaveGamePath(SaveName)));
+	if (!FileReader)
+	{
+		FLOGV("Fail to read save '%s'", *GetBinarySaveGamePath(SaveName));
+		return NULL;
+	}
 
+	FFlareBinarySaveHeader Header;
+	*FileReader << Header;
 
-void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
-{
-	SaveListLock.Lock();
-	SaveList.Add(SaveData);
-	SaveListLock.Unlock();
+	if (FileReader->IsError() || Header.Magic != FLARE_BINARY_SAVE_MAGIC)
+	{
+		FLOGV("Save '%s' is not a binary save", *GetBinarySaveGamePath(SaveName));
+		return NULL;
+	}
+	else if (Header.FormatVersion > FLARE_BINARY_SAVE_VERSION)
+	{
+		FLOGV("Save '%s' uses format %d, this game only reads up to %d", *GetBinarySaveGamePath(SaveName), Header.FormatVersion, FLARE_BINARY_SAVE_VERSION);
+		return NULL;
+	}
+
+	// Read with the versions the save was written with
+	FileReader->SetUE4Ver(Header.UE4Version);
+	FileReader->SetLicenseeUE4Ver(Header.LicenseeUE4Version);
+	FileReader->SetEngineVer(Header.EngineVersion);
+	FileReader->SetCustomVersions(Header.CustomVersions);
+
+	UFlareSaveGame* SaveGame = NewObject<UFlareSaveGame>(this, UFlareSaveGame::StaticClass());
+
+	// Older saves store the properties uncompressed, right after the header
+	if (Header.FormatVersion < FLARE_BINARY_SAVE_VERSION_COMPRESSED)
+	{
+		FObjectAndNameAsStringProxyArchive Ar(*FileReader, true);
+		SaveGame->Serialize(Ar);
+
+		if (FileReader->IsError())
+		{
+			FLOGV("Fail to deserialize save '%s'", *GetBinarySaveGamePath(SaveName));
+			return NULL;
+		}
+
+		return SaveGame;
+	}
+
+	// Uncompress the payload
+	int32 UncompressedSize = 0;
+	TArray<uint8> CompressedPayload;
+	*FileReader << UncompressedSize;
+	*FileReader << CompressedPayload;
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(UncompressedSize);
+	if (FileReader->IsError() || !FCompression::UncompressMemory(COMPRESS_ZLIB, Payload.GetData(), UncompressedSize, CompressedPayload.GetData(), CompressedPayload.Num()))
+	{
+		FLOGV("Fail to uncompress save '%s'", *GetBinarySaveGamePath(SaveName));
+		return NULL;
+	}
+	double UncompressTs = FPlatformTime::Seconds();
+
+	FMemoryReader PayloadReader(Payload, true);
+	PayloadReader.SetUE4Ver(Header.UE4Version);
+	PayloadReader.SetLicenseeUE4Ver(Header.LicenseeUE4Version);
+	PayloadReader.SetEngineVer(Header.EngineVersion);
+	PayloadReader.SetCustomVersions(Header.CustomVersions);
+
+	FObjectAndNameAsStringProxyArchive Ar(PayloadReader, true);
+	SaveGame->Serialize(Ar);
+
+	if (PayloadReader.IsError())
+	{
+		FLOGV("Fail to deserialize save '%s'", *GetBinarySaveGamePath(SaveName));
+		return NULL;
+	}
+
+	FLOGV("UFlareSaveGameSystem::LoadGameBinary : read %.2fms, save data %.2fms",
+		(UncompressTs - StartTs) * 1000, (FPlatformTime::Seconds() - UncompressTs) * 1000);
+
+	return SaveGame;
 }
 
 
@@ -116,3 +567,13 @@ FString UFlareSaveGameSystem::GetSaveGamePath(const FString SaveName)
 {
 	return FString::Printf(TEXT("%s/SaveGames/%s.json"), *FPaths::GameSavedDir(), *SaveName);
 }
+
+FString UFlareSaveGameSystem::GetBinarySaveGamePath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.hrsave"), *FPaths::GameSavedDir(), *SaveName);
+}
+
+FString UFlareSaveGameSystem::GetTemporarySaveGamePath(const FString FileName)
+{
+	return FileName + TEXT(".tmp");
+}
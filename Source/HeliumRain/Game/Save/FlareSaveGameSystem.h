@@ -1,10 +1,80 @@
-
 #pragma once
 
 #include "Object.h"
+#include "Misc/EngineVersion.h"
+#include "Serialization/CustomVersion.h"
 #include "FlareSaveGameSystem.generated.h"
 
 class UFlareSaveGame;
+class UFlareSaveWriter;
+
+
+/** Binary save identification */
+#define FLARE_BINARY_SAVE_MAGIC 0x56415348
+
+/** Binary save schema version, increase when the save structures change in a non-compatible way */
+#define FLARE_BINARY_SAVE_VERSION 3
+
+/** First binary save version with a metadata block in the header */
+#define FLARE_BINARY_SAVE_VERSION_METADATA 2
+
+/** First binary save version with a compressed payload */
+#define FLARE_BINARY_SAVE_VERSION_COMPRESSED 3
+
+/** Bytes read from the start of a JSON save when looking for its metadata block */
+#define FLARE_JSON_SAVE_METADATA_READ_SIZE 16384
+
+
+/** Save file format */
+UENUM()
+namespace EFlareSaveFormat
+{
+	enum Type
+	{
+		Json,
+		Binary
+	};
+}
+
+/** Save summary stored at the start of every save, readable without loading the world */
+struct FFlareSaveMetadata
+{
+	int32                       FormatVersion;
+	FName                       UUID;
+	FName                       CompanyIdentifier;
+	FText                       CompanyName;
+	int64                       CompanyValue;
+	int32                       CompanyShipCount;
+	int64                       Date;
+	int32                       PlayerEmblemIndex;
+	FLinearColor                BasePaintColor;
+	FLinearColor                PaintColor;
+	FLinearColor                OverlayColor;
+	FLinearColor                LightColor;
+
+	/** Summarize a save */
+	void Init(UFlareSaveGame* SaveData, int32 SaveFormatVersion);
+
+	friend FArchive& operator<<(FArchive& Ar, FFlareSaveMetadata& Metadata);
+};
+
+/** Binary save file header */
+struct FFlareBinarySaveHeader
+{
+	uint32                      Magic;
+	int32                       FormatVersion;
+	int32                       UE4Version;
+	int32                       LicenseeUE4Version;
+	FEngineVersion              EngineVersion;
+	FCustomVersionContainer     CustomVersions;
+	FFlareSaveMetadata          Metadata;
+
+	/** Fill the header for the running game */
+	void Init(UFlareSaveGame* SaveData);
+
+	friend FArchive& operator<<(FArchive& Ar, FFlareBinarySaveHeader& Header);
+};
+
 
 UCLASS()
 class HELIUMRAIN_API UFlareSaveGameSystem: public UObject
@@ -31,8 +101,42 @@ public:
 	/* Keep Save data reference for the async save*/
 	virtual void PushSaveData(UFlareSaveGame* SaveData);
 
+	/** Read the save summary without loading the world. Return false if the save has none */
+	virtual bool LoadMetadata(const FString SaveName, FFlareSaveMetadata& Metadata);
+
+	/** Rewrite an existing save in another format */
+	virtual bool ConvertGame(const FString SaveName, EFlareSaveFormat::Type TargetFormat);
+
+	/** Set the format used for new saves */
+	void SetSaveFormat(EFlareSaveFormat::Type Format)
+	{
+		SaveFormat = Format;
+	}
+
 protected:
 
+	/*----------------------------------------------------
+		Formats
+	----------------------------------------------------*/
+
+	bool SaveGameJson(const FString SaveName, UFlareSaveGame* SaveData);
+
+	bool SaveGameBinary(const FString SaveName, UFlareSaveGame* SaveData);
+
+	UFlareSaveGame* LoadGameJson(const FString SaveName);
+
+	UFlareSaveGame* LoadGameBinary(const FString SaveName);
+
+	bool LoadMetadataJson(const FString SaveName, FFlareSaveMetadata& Metadata);
+
+	bool LoadMetadataBinary(const FString SaveName, FFlareSaveMetadata& Metadata);
+
+	/** Write the save in the requested format, and remove the copy in the other format */
+	bool WriteGame(const FString SaveName, UFlareSaveGame* SaveData, EFlareSaveFormat::Type Format);
+
+	/** Replace a save file with a fully written temporary file, so that an interrupted save never corrupts the previous one */
+	bool CommitSaveFile(const FString TempFileName, const FString FileName);
+
 
 	/*----------------------------------------------------
 		Protected data
@@ -45,6 +149,12 @@ protected:
 	UPROPERTY()
 	TArray<UFlareSaveGame *> SaveList;
 
+	// Created on the game thread, used by the save workers
+	UPROPERTY()
+	UFlareSaveWriter* SaveWriter;
+
+	EFlareSaveFormat::Type SaveFormat;
+
 
 public:
 
@@ -55,4 +165,15 @@ public:
    /** Get the path to save game file for the given name, a platform _may_ be able to simply override this and no other functions above */
    static FString GetSaveGamePath(const FString SaveName);
 
+   /** Get the path to the binary save game file for the given name */
+   static FString GetBinarySaveGamePath(const FString SaveName);
+
+   /** Get the path of the file a save is written to before replacing the real one */
+   static FString GetTemporarySaveGamePath(const FString FileName);
+
+   EFlareSaveFormat::Type GetSaveFormat() const
+   {
+	   return SaveFormat;
+   }
+
 };
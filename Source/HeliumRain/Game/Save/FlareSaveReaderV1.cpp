@@ -3,12 +3,15 @@
 #include "../../Flare.h"
 
 #include "FlareSaveWriter.h"
+#include "FlareSaveGameSystem.h"
 
 #include "../FlareSaveGame.h"
 #include "../FlareGameTools.h"
 
 #include "../../UI/Style/FlareStyleSet.h"
 
+#include "Async/ParallelFor.h"
+
 
 /*----------------------------------------------------
 	Constructor
@@ -16,6 +19,12 @@
 
 UFlareSaveReaderV1::UFlareSaveReaderV1(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, DefaultFleetColor(FLinearColor::White)
+	, SpawnModeEnum(NULL)
+	, TradeRouteOperationEnum(NULL)
+	, ResourceLockEnum(NULL)
+	, ResourceRestrictionEnum(NULL)
+	, SectorKnowledgeEnum(NULL)
 {
 }
 
@@ -74,6 +83,28 @@ UFlareSaveGame* UFlareSaveReaderV1::LoadGame(TSharedPtr< FJsonObject > GameObjec
 	return SaveGame;
 }
 
+void UFlareSaveReaderV1::LoadMetadata(const TSharedPtr<FJsonObject> Object, FFlareSaveMetadata* Data)
+{
+	LoadInt32(Object, "FormatVersion", &Data->FormatVersion);
+	LoadFName(Object, "UUID", &Data->UUID);
+	LoadFName(Object, "CompanyIdentifier", &Data->CompanyIdentifier);
+	LoadFText(Object, "CompanyName", &Data->CompanyName);
+	LoadInt64(Object, "CompanyValue", &Data->CompanyValue);
+	LoadInt32(Object, "CompanyShipCount", &Data->CompanyShipCount);
+	LoadInt64(Object, "Date", &Data->Date);
+	LoadInt32(Object, "PlayerEmblemIndex", &Data->PlayerEmblemIndex);
+
+	FVector Temp;
+	LoadVector(Object, "BasePaintColor", &Temp);
+	Data->BasePaintColor = FLinearColor(Temp);
+	LoadVector(Object, "PaintColor", &Temp);
+	Data->PaintColor = FLinearColor(Temp);
+	LoadVector(Object, "OverlayColor", &Temp);
+	Data->OverlayColor = FLinearColor(Temp);
+	LoadVector(Object, "LightColor", &Temp);
+	Data->LightColor = FLinearColor(Temp);
+}
+
 void UFlareSaveReaderV1::LoadPlayer(const TSharedPtr<FJsonObject> Object, FFlarePlayerSave* Data)
 {
 	LoadFName(Object, "UUID", &Data->UUID);
@@ -137,7 +168,7 @@ void UFlareSaveReaderV1::LoadQuest(const TSharedPtr<FJsonObject> Object, FFlareQ
 void UFlareSaveReaderV1::LoadQuestProgress(const TSharedPtr<FJsonObject> Object, FFlareQuestProgressSave* Data)
 {
 	LoadFName(Object, "QuestIdentifier", &Data->QuestIdentifier);
-	Data->Status = LoadEnum<EFlareQuestStatus::Type>(Object, "Status", "EFlareQuestStatus");
+	Data->Status = LoadEnum<EFlareQuestStatus::Type>(Object, "Status", FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareQuestStatus"), true));
 
 	LoadInt64(Object, "AvailableDate", &Data->AvailableDate);
 	LoadInt64(Object, "AcceptationDate", &Data->AcceptationDate);
@@ -214,40 +245,52 @@ void UFlareSaveReaderV1::LoadCompanyDescription(const TSharedPtr<FJsonObject> Ob
 
 void UFlareSaveReaderV1::LoadWorld(const TSharedPtr<FJsonObject> Object, FFlareWorldSave* Data)
 {
+	double StartTs = FPlatformTime::Seconds();
 	LoadInt64(Object, "Date", &Data->Date);
 
-	const TArray<TSharedPtr<FJsonValue>>* Companies;
-	if(Object->TryGetArrayField("Companies", Companies))
-	{
-		for (TSharedPtr<FJsonValue> Item : *Companies)
+	// Style data and object lookups can't be done from the workers
+	DefaultFleetColor = FFlareStyleSet::GetDefaultTheme().NeutralColor;
+	SpawnModeEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareSpawnMode"), true);
+	TradeRouteOperationEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareTradeRouteOperation"), true);
+	ResourceLockEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareResourceLock"), true);
+	ResourceRestrictionEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareResourceRestriction"), true);
+	SectorKnowledgeEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EFlareSectorKnowledge"), true);
+
+	const TArray<TSharedPtr<FJsonValue>>* Companies = NULL;
+	const TArray<TSharedPtr<FJsonValue>>* Sectors = NULL;
+	const TArray<TSharedPtr<FJsonValue>>* Travels = NULL;
+	Object->TryGetArrayField("Companies", Companies);
+	Object->TryGetArrayField("Sectors", Sectors);
+	Object->TryGetArrayField("Travels", Travels);
+
+	int32 CompanyCount = Companies ? Companies->Num() : 0;
+	int32 SectorCount = Sectors ? Sectors->Num() : 0;
+	int32 TravelCount = Travels ? Travels->Num() : 0;
+	Data->CompanyData.SetNum(CompanyCount);
+	Data->SectorData.SetNum(SectorCount);
+	Data->TravelData.SetNum(TravelCount);
+
+	// Blocks only read their own JSON subtree and write their own save entry, so they can be parsed concurrently
+	ParallelFor(CompanyCount + SectorCount + TravelCount, [&](int32 BlockIndex)
+	{
+		if (BlockIndex < CompanyCount)
 		{
-			FFlareCompanySave ChildData;
-			LoadCompany(Item->AsObject(), &ChildData);
-			Data->CompanyData.Add(ChildData);
+			LoadCompany((*Companies)[BlockIndex]->AsObject(), &Data->CompanyData[BlockIndex]);
 		}
-	}
-
-	const TArray<TSharedPtr<FJsonValue>>* Sectors;
-	if(Object->TryGetArrayField("Sectors", Sectors))
-	{
-		for (TSharedPtr<FJsonValue> Item : *Sectors)
+		else if (BlockIndex < CompanyCount + SectorCount)
 		{
-			FFlareSectorSave ChildData;
-			LoadSector(Item->AsObject(), &ChildData);
-			Data->SectorData.Add(ChildData);
+			int32 SectorIndex = BlockIndex - CompanyCount;
+			LoadSector((*Sectors)[SectorIndex]->AsObject(), &Data->SectorData[SectorIndex]);
 		}
-	}
-
-	const TArray<TSharedPtr<FJsonValue>>* Travels;
-	if(Object->TryGetArrayField("Travels", Travels))
-	{
-		for (TSharedPtr<FJsonValue> Item : *Travels)
+		else
 		{
-			FFlareTravelSave ChildData;
-			LoadTravel(Item->AsObject(), &ChildData);
-			Data->TravelData.Add(ChildData);
+			int32 TravelIndex = BlockIndex - CompanyCount - SectorCount;
+			LoadTravel((*Travels)[TravelIndex]->AsObject(), &Data->TravelData[TravelIndex]);
 		}
-	}
+	});
+
+	FLOGV("UFlareSaveReaderV1::LoadWorld : parsed %d companies, %d sectors, %d travels in %.2fms",
+		CompanyCount, SectorCount, TravelCount, (FPlatformTime::Seconds() - StartTs) * 1000);
 }
 
 
@@ -375,7 +418,7 @@ void UFlareSaveReaderV1::LoadSpacecraft(const TSharedPtr<FJsonObject> Object, FF
 	LoadFName(Object, "CompanyIdentifier", &Data->CompanyIdentifier);
 	LoadVector(Object, "Location", &Data->Location);
 	LoadRotator(Object, "Rotation", &Data->Rotation);
-	Data->SpawnMode = LoadEnum<EFlareSpawnMode::Type>(Object, "SpawnMode", "EFlareSpawnMode");
+	Data->SpawnMode = LoadEnum<EFlareSpawnMode::Type>(Object, "SpawnMode", SpawnModeEnum);
 	LoadVector(Object, "LinearVelocity", &Data->LinearVelocity);
 	LoadVector(Object, "AngularVelocity", &Data->AngularVelocity);
 	LoadFName(Object, "DockedTo", &Data->DockedTo);
@@ -620,15 +663,15 @@ void UFlareSaveReaderV1::LoadTradeOperation(const TSharedPtr<FJsonObject> Object
 	LoadFName(Object, "ResourceIdentifier", &Data->ResourceIdentifier);
 	LoadInt32(Object, "MaxQuantity", (int32*) &Data->MaxQuantity);
 	LoadInt32(Object, "MaxWait", (int32*) &Data->MaxWait);
-	Data->Type = LoadEnum<EFlareTradeRouteOperation::Type>(Object, "Type", "EFlareTradeRouteOperation");
+	Data->Type = LoadEnum<EFlareTradeRouteOperation::Type>(Object, "Type", TradeRouteOperationEnum);
 }
 
 void UFlareSaveReaderV1::LoadCargo(const TSharedPtr<FJsonObject> Object, FFlareCargoSave* Data)
 {
 	LoadFName(Object, "ResourceIdentifier", &Data->ResourceIdentifier);
 	LoadInt32(Object, "Quantity", (int32*) &Data->Quantity); // TODO clean after conversion
-	Data->Lock = LoadEnum<EFlareResourceLock::Type>(Object, "Lock", "EFlareResourceLock");
-	Data->Restriction = LoadEnum<EFlareResourceRestriction::Type>(Object, "Restriction", "EFlareResourceRestriction");
+	Data->Lock = LoadEnum<EFlareResourceLock::Type>(Object, "Lock", ResourceLockEnum);
+	Data->Restriction = LoadEnum<EFlareResourceRestriction::Type>(Object, "Restriction", ResourceRestrictionEnum);
 }
 
 void UFlareSaveReaderV1::LoadShipyardOrder(const TSharedPtr<FJsonObject> Object, FFlareShipyardOrderSave* Data)
@@ -700,8 +743,7 @@ void UFlareSaveReaderV1::LoadFleet(const TSharedPtr<FJsonObject> Object, FFlareF
 	}
 	else
 	{
-		const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
-		Data->FleetColor = Theme.NeutralColor;
+		Data->FleetColor = DefaultFleetColor;
 	}
 }
 
@@ -814,7 +856,7 @@ void UFlareSaveReaderV1::LoadTradeRouteSector(const TSharedPtr<FJsonObject> Obje
 void UFlareSaveReaderV1::LoadSectorKnowledge(const TSharedPtr<FJsonObject> Object, FFlareCompanySectorKnowledge* Data)
 {
 	LoadFName(Object, "SectorIdentifier", &Data->SectorIdentifier);
-	Data->Knowledge = LoadEnum<EFlareSectorKnowledge::Type>(Object, "Knowledge", "EFlareSectorKnowledge");
+	Data->Knowledge = LoadEnum<EFlareSectorKnowledge::Type>(Object, "Knowledge", SectorKnowledgeEnum);
 }
 
 
@@ -1229,7 +1271,7 @@ void UFlareSaveReaderV1::LoadBundle(const TSharedPtr<FJsonObject> Object, FStrin
 			{
 				FName FloatKey = FName(*Pair.Key);
 				float FloatValue = Pair.Value->AsNumber();
-				Data->FloatValues.Add(FloatKey, FloatValue);
+				Data->PutFloat(FloatKey, FloatValue);
 			}
 		}
 
@@ -1241,7 +1283,7 @@ void UFlareSaveReaderV1::LoadBundle(const TSharedPtr<FJsonObject> Object, FStrin
 				FName Int32Key = FName(*Pair.Key);
 				int32 Int32Value;
 				ParseInt32(Pair.Value->AsString(), &Int32Value);
-				Data->Int32Values.Add(Int32Key, Int32Value);
+				Data->PutInt32(Int32Key, Int32Value);
 			}
 		}
 
@@ -1253,7 +1295,7 @@ void UFlareSaveReaderV1::LoadBundle(const TSharedPtr<FJsonObject> Object, FStrin
 				FName TransformKey = FName(*Pair.Key);
 				FTransform TransformValue;
 				ParseTransform(Pair.Value->AsString(), &TransformValue);
-				Data->TransformValues.Add(TransformKey, TransformValue);
+				Data->PutTransform(TransformKey, TransformValue);
 			}
 		}
 
@@ -1289,7 +1331,7 @@ void UFlareSaveReaderV1::LoadBundle(const TSharedPtr<FJsonObject> Object, FStrin
 			{
 				FName NameKey = FName(*Pair.Key);
 				FName NameValue = FName(*Pair.Value->AsString());
-				Data->NameValues.Add(NameKey, NameValue);
+				Data->PutName(NameKey, NameValue);
 			}
 		}
 
@@ -1322,11 +1364,16 @@ void UFlareSaveReaderV1::LoadBundle(const TSharedPtr<FJsonObject> Object, FStrin
 			{
 				FName NameKey = FName(*Pair.Key);
 				FString StringValue = *Pair.Value->AsString();
-				Data->StringValues.Add(NameKey, StringValue);
+				Data->PutString(NameKey, StringValue);
 			}
 		}
 
-		LoadFNameArray(*Bundle, "Tags", &Data->Tags);
+		TArray<FName> Tags;
+		LoadFNameArray(*Bundle, "Tags", &Tags);
+		for (FName Tag : Tags)
+		{
+			Data->PutTag(Tag);
+		}
 	}
 	else
 	{
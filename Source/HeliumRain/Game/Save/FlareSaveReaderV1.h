@@ -8,6 +8,7 @@
 class UFlareSaveGame;
 struct FFlareTradeRouteSectorOperationSave;
 struct FFlareFloatBuffer;
+struct FFlareSaveMetadata;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSaveReaderV1: public UObject
@@ -17,6 +18,8 @@ class HELIUMRAIN_API UFlareSaveReaderV1: public UObject
 public:
 	UFlareSaveGame* LoadGame(TSharedPtr< FJsonObject > GameObject);
 
+	void LoadMetadata(const TSharedPtr<FJsonObject> Object, FFlareSaveMetadata* Data);
+
 protected:
 	/*----------------------------------------------------
 	  Loaders
@@ -68,6 +71,15 @@ protected:
 		Protected data
 	----------------------------------------------------*/
 
+	/** Fleet color for saves that don't have one, read before the parallel parsing */
+	FLinearColor                               DefaultFleetColor;
+
+	/** Enums read by the world loaders, found before the parallel parsing */
+	UEnum*                                     SpawnModeEnum;
+	UEnum*                                     TradeRouteOperationEnum;
+	UEnum*                                     ResourceLockEnum;
+	UEnum*                                     ResourceRestrictionEnum;
+	UEnum*                                     SectorKnowledgeEnum;
 
 
 public:
@@ -93,16 +105,11 @@ public:
 
 
 	template <typename EnumType>
-	static FORCEINLINE EnumType LoadEnum(TSharedPtr< FJsonObject > Object, FString Key, const FString& EnumName)
+	static FORCEINLINE EnumType LoadEnum(TSharedPtr< FJsonObject > Object, FString Key, const UEnum* Enum)
 	{
 		FString DataString;
-		if(Object->TryGetStringField(Key, DataString))
+		if(Enum && Object->TryGetStringField(Key, DataString))
 		{
-			UEnum* Enum = FindObject<UEnum>(ANY_PACKAGE, *EnumName, true);
-			if(!Enum)
-				{
-				  return EnumType(0);
-				}
 			return (EnumType)Enum->GetIndexByName(FName(*DataString));
 		}
 		return EnumType(0);
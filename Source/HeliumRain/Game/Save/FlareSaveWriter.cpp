@@ -3,6 +3,7 @@
 #include "../../Flare.h"
 #include "../FlareSaveGame.h"
 #include "Game/FlareGameTools.h"
+#include "FlareSaveGameSystem.h"
 
 /*----------------------------------------------------
 	Constructor
@@ -17,6 +18,11 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveGame(UFlareSaveGame* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 
+	// Summary first, so that it can be read without parsing the world
+	FFlareSaveMetadata Metadata;
+	Metadata.Init(Data, 1);
+	JsonObject->SetObjectField("Metadata", SaveMetadata(&Metadata));
+
 	// General stuff
 	JsonObject->SetStringField("Game", "Helium Rain");
 	JsonObject->SetStringField("SaveFormat", FormatInt32(1));
@@ -37,6 +43,26 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveGame(UFlareSaveGame* Data)
 	Generator
 ----------------------------------------------------*/
 
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveMetadata(FFlareSaveMetadata* Data)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+	JsonObject->SetStringField("FormatVersion", FormatInt32(Data->FormatVersion));
+	JsonObject->SetStringField("UUID", Data->UUID.ToString());
+	JsonObject->SetStringField("CompanyIdentifier", Data->CompanyIdentifier.ToString());
+	JsonObject->SetStringField("CompanyName", Data->CompanyName.ToString());
+	JsonObject->SetStringField("CompanyValue", FormatInt64(Data->CompanyValue));
+	JsonObject->SetStringField("CompanyShipCount", FormatInt32(Data->CompanyShipCount));
+	JsonObject->SetStringField("Date", FormatInt64(Data->Date));
+	JsonObject->SetStringField("PlayerEmblemIndex", FormatInt32(Data->PlayerEmblemIndex));
+	JsonObject->SetStringField("BasePaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->BasePaintColor)));
+	JsonObject->SetStringField("PaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->PaintColor)));
+	JsonObject->SetStringField("OverlayColor", FormatVector(UFlareGameTools::ColorToVector(Data->OverlayColor)));
+	JsonObject->SetStringField("LightColor", FormatVector(UFlareGameTools::ColorToVector(Data->LightColor)));
+
+	return JsonObject;
+}
+
 TSharedRef<FJsonObject> UFlareSaveWriter::SavePlayer(FFlarePlayerSave* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
@@ -816,94 +842,102 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveBundle(FFlareBundle* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 
-	if(Data->FloatValues.Num() > 0)
+	TArray<FName> FloatKeys = Data->GetKeys(EFlareBundleType::Float);
+	if(FloatKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> FloatObject = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->FloatValues)
+		for (FName Key : FloatKeys)
 		{
-			FloatObject->SetNumberField(Pair.Key.ToString(), FixFloat(Pair.Value));
+			FloatObject->SetNumberField(Key.ToString(), FixFloat(Data->GetFloat(Key)));
 		}
 		JsonObject->SetObjectField("FloatValues", FloatObject);
 	}
 
-	if(Data->Int32Values.Num() > 0)
+	TArray<FName> Int32Keys = Data->GetKeys(EFlareBundleType::Int32);
+	if(Int32Keys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> Int32Object = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->Int32Values)
+		for (FName Key : Int32Keys)
 		{
-			Int32Object->SetStringField(Pair.Key.ToString(), FormatInt32(Pair.Value));
+			Int32Object->SetStringField(Key.ToString(), FormatInt32(Data->GetInt32(Key)));
 		}
 		JsonObject->SetObjectField("Int32Values", Int32Object);
 	}
 
-	if(Data->TransformValues.Num() > 0)
+	TArray<FName> TransformKeys = Data->GetKeys(EFlareBundleType::Transform);
+	if(TransformKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->TransformValues)
+		for (FName Key : TransformKeys)
 		{
-			TransformObject->SetStringField(Pair.Key.ToString(), FormatTransform(Pair.Value));
+			TransformObject->SetStringField(Key.ToString(), FormatTransform(Data->GetTransform(Key)));
 		}
 		JsonObject->SetObjectField("TransformValues", TransformObject);
 	}
 
-	if(Data->VectorArrayValues.Num() > 0)
+	TArray<FName> VectorArrayKeys = Data->GetKeys(EFlareBundleType::VectorArray);
+	if(VectorArrayKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->VectorArrayValues)
+		for (FName Key : VectorArrayKeys)
 		{
 			TArray< TSharedPtr<FJsonValue> > VectorArray;
-			for(FVector Vector: Pair.Value.Entries)
+			for(FVector Vector: Data->GetVectorArray(Key))
 			{
 				VectorArray.Add(MakeShareable(new FJsonValueString(FormatVector(Vector))));
 			}
 
-			TransformObject->SetArrayField(Pair.Key.ToString(), VectorArray);
+			TransformObject->SetArrayField(Key.ToString(), VectorArray);
 		}
 		JsonObject->SetObjectField("VectorArrayValues", TransformObject);
 	}
 
-	if(Data->NameValues.Num() > 0)
+	TArray<FName> NameKeys = Data->GetKeys(EFlareBundleType::Name);
+	if(NameKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> Int32Object = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->NameValues)
+		for (FName Key : NameKeys)
 		{
-			Int32Object->SetStringField(Pair.Key.ToString(), Pair.Value.ToString());
+			Int32Object->SetStringField(Key.ToString(), Data->GetName(Key).ToString());
 		}
 		JsonObject->SetObjectField("NameValues", Int32Object);
 	}
 	
-	if(Data->NameArrayValues.Num() > 0)
+	TArray<FName> NameArrayKeys = Data->GetKeys(EFlareBundleType::NameArray);
+	if(NameArrayKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->NameArrayValues)
+		for (FName Key : NameArrayKeys)
 		{
 			TArray< TSharedPtr<FJsonValue> > NameArray;
-			for(FName Name: Pair.Value.Entries)
+			for(FName Name: Data->GetNameArray(Key))
 			{
 				NameArray.Add(MakeShareable(new FJsonValueString(Name.ToString())));
 			}
 
-			TransformObject->SetArrayField(Pair.Key.ToString(), NameArray);
+			TransformObject->SetArrayField(Key.ToString(), NameArray);
 		}
 		JsonObject->SetObjectField("NameArrayValues", TransformObject);
 	}
 
-	if (Data->StringValues.Num() > 0)
+	TArray<FName> StringKeys = Data->GetKeys(EFlareBundleType::String);
+	if (StringKeys.Num() > 0)
 	{
 		TSharedRef<FJsonObject> StringObject = MakeShareable(new FJsonObject());
-		for (auto& Pair : Data->StringValues)
+		for (FName Key : StringKeys)
 		{
-			StringObject->SetStringField(Pair.Key.ToString(), Pair.Value);
+			StringObject->SetStringField(Key.ToString(), Data->GetString(Key));
 		}
 		JsonObject->SetObjectField("StringValues", StringObject);
 	}
 
-	if (Data->Tags.Num() > 0)
+	TArray<FName> TagKeys = Data->GetKeys(EFlareBundleType::Tag);
+	if (TagKeys.Num() > 0)
 	{
 		TArray< TSharedPtr<FJsonValue> > Tags;
-		for(int i = 0; i < Data->Tags.Num(); i++)
+		for(int i = 0; i < TagKeys.Num(); i++)
 		{
-			Tags.Add(MakeShareable(new FJsonValueString(Data->Tags[i].ToString())));
+			Tags.Add(MakeShareable(new FJsonValueString(TagKeys[i].ToString())));
 		}
 		JsonObject->SetArrayField("Tags", Tags);
 	}
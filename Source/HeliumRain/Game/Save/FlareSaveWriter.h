@@ -42,6 +42,7 @@ struct FFlareBombSave;
 struct FFFlareResourcePrice;
 struct FFlareTravelSave;
 struct FFlareFloatBuffer;
+struct FFlareSaveMetadata;
 
 
 
@@ -59,6 +60,7 @@ protected:
 	  Generator
 	----------------------------------------------------*/
 
+	TSharedRef<FJsonObject> SaveMetadata(FFlareSaveMetadata* Data);
 	TSharedRef<FJsonObject> SavePlayer(FFlarePlayerSave* Data);
 	TSharedRef<FJsonObject> SaveQuest(FFlareQuestSave* Data);
 	TSharedRef<FJsonObject> SaveQuestProgress(FFlareQuestProgressSave* Data);
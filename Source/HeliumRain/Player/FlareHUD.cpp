@@ -7,6 +7,7 @@
 #include "../Game/FlareGame.h"
 #include "../Game/FlareGameTools.h"
 #include "../Game/FlareSector.h"
+#include "../Game/FlareWorld.h"
 #include "../Game/AI/FlareCompanyAI.h"
 #include "../Game/FlareGameUserSettings.h"
 
@@ -44,6 +45,7 @@ AFlareHUD::AFlareHUD(const class FObjectInitializer& PCIP)
 	, CurrentPowerTime(0)
 	, PowerTransitionTime(0.5f)
 	, ShowPerformance(false)
+	, ShowSimulationProfile(false)
 	, PerformanceTimer(0)
 	, FrameTime(0)
 	, GameThreadTime(0)
@@ -339,6 +341,21 @@ void AFlareHUD::DrawHUD()
 				FlareDrawText(VelocityText, FVector2D(0, 70), HUDNosePowerColor, true);
 			}
 		}
+
+		// Sector activation progress
+		UFlareSector* ActiveSector = PC->GetGame()->GetActiveSector();
+		if (ActiveSector && ActiveSector->IsLoading())
+		{
+			int32 Progress = FMath::RoundToInt(100 * ActiveSector->GetLoadingProgress());
+			FText LoadingText = FText::Format(LOCTEXT("SectorLoadingFormat", "Loading sector... {0}%"), FText::AsNumber(Progress));
+			FlareDrawText(LoadingText, FVector2D(0, -70), HudColorNeutral, true);
+		}
+
+		// Simulation timings
+		if (ShowSimulationProfile)
+		{
+			DrawSimulationProfile(PC);
+		}
 	}
 
 	// Player hit management
@@ -485,6 +502,11 @@ void AFlareHUD::TogglePerformance()
 	ShowPerformance = !ShowPerformance;
 }
 
+void AFlareHUD::ToggleSimulationProfile()
+{
+	ShowSimulationProfile = !ShowSimulationProfile;
+}
+
 
 /*----------------------------------------------------
 	Cockpit HUD drawing
@@ -1507,6 +1529,54 @@ FText AFlareHUD::FormatDistance(float Distance)
 	}
 }
 
+void AFlareHUD::DrawSimulationProfile(AFlarePlayerController* PC)
+{
+	UFlareWorld* World = PC->GetGame()->GetGameWorld();
+	if (!World || World->GetSimulationProfiler().Num() == 0)
+	{
+		return;
+	}
+
+	const FFlareSimulationTimings& Day = World->GetSimulationProfiler().GetLastDay();
+	FVector2D CurrentPos = FVector2D(50, 100);
+
+	FlareDrawText(FText::FromString(FString::Printf(TEXT("Day %lld : %.2fms, %u allocations"),
+		Day.Date, Day.TotalTime * 1000, Day.TotalAllocations)), CurrentPos, HudColorNeutral, false);
+	CurrentPos += InstrumentLine;
+
+	// Phases
+	for (int32 Phase = 0; Phase < EFlareSimulationPhase::Num; Phase++)
+	{
+		FlareDrawText(FText::FromString(FString::Printf(TEXT("%s : %.2fms, %u allocations"),
+			*FFlareSimulationProfiler::GetPhaseName((EFlareSimulationPhase::Type) Phase),
+			Day.PhaseTimes[Phase] * 1000, Day.PhaseAllocations[Phase])), CurrentPos, HudColorNeutral, false);
+		CurrentPos += InstrumentLine;
+	}
+	CurrentPos += InstrumentLine;
+
+	// Company AI, slowest first
+	TArray<FFlareCompanyAITimings> CompanyAI = Day.CompanyAI;
+	CompanyAI.Sort([](const FFlareCompanyAITimings& A, const FFlareCompanyAITimings& B)
+	{
+		return A.StepTimes[EFlareAIStep::UpdateTrading] + A.StepTimes[EFlareAIStep::ProcessBudget] + A.StepTimes[EFlareAIStep::UpdateMilitaryMovement]
+			 > B.StepTimes[EFlareAIStep::UpdateTrading] + B.StepTimes[EFlareAIStep::ProcessBudget] + B.StepTimes[EFlareAIStep::UpdateMilitaryMovement];
+	});
+
+	for (const FFlareCompanyAITimings& CompanyTimings : CompanyAI)
+	{
+		FString CompanyText = CompanyTimings.Company.ToString() + TEXT(" :");
+		for (int32 Step = 0; Step < EFlareAIStep::Num; Step++)
+		{
+			CompanyText += FString::Printf(TEXT(" %s %.2fms (%u)"),
+				*FFlareSimulationProfiler::GetAIStepName((EFlareAIStep::Type) Step),
+				CompanyTimings.StepTimes[Step] * 1000, CompanyTimings.StepAllocations[Step]);
+		}
+
+		FlareDrawText(FText::FromString(CompanyText), CurrentPos, HudColorNeutral, false);
+		CurrentPos += InstrumentLine;
+	}
+}
+
 void AFlareHUD::DrawSpeed(AFlarePlayerController* PC, AActor* Object, UTexture2D* Icon, FVector Speed)
 {
 	// Get HUD data
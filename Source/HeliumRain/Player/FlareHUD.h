@@ -74,6 +74,9 @@ public:
 	/** Toggle performance counters */
 	void TogglePerformance();
 
+	/** Toggle the world simulation timings */
+	void ToggleSimulationProfile();
+
 
 	/*----------------------------------------------------
 		Cockpit
@@ -131,6 +134,9 @@ protected:
 	/** Drawing debug grid*/
 	void DrawDebugGrid (FLinearColor Color);
 
+	/** Draw the phase and company AI timings of the last simulated day */
+	void DrawSimulationProfile(AFlarePlayerController* PC);
+
 	/** Draw speed indicator */
 	void DrawSpeed(AFlarePlayerController* PC, AActor* Object, UTexture2D* Icon, FVector Speed);
 
@@ -316,6 +322,7 @@ protected:
 	float                                   RenderThreadTime;
 	float                                   GPUFrameTime;
 	FText                                   PerformanceText;
+	bool                                    ShowSimulationProfile;
 
 public:
 
@@ -101,6 +101,7 @@ AFlarePlayerController::AFlarePlayerController(const class FObjectInitializer& P
 	QuickSwitchNextOffset = 0;
 	HasCurrentObjective = false;
 	RightMousePressed = false;
+	DeferNotifications = false;
 	LastBattleState.Init();
 
 	// Setup
@@ -751,6 +752,30 @@ void AFlarePlayerController::Notify(FText Title, FText Info, FName Tag, EFlareNo
 {
 	FLOGV("AFlarePlayerController::Notify : '%s'", *Title.ToString());
 
+	// Batch simulation : keep the last notification for each tag
+	if (DeferNotifications)
+	{
+		FFlareDeferredNotification Notification;
+		Notification.Text = Title;
+		Notification.Info = Info;
+		Notification.Tag = Tag;
+		Notification.Type = Type;
+		Notification.Pinned = Pinned;
+		Notification.TargetMenu = TargetMenu;
+		Notification.TargetInfo = TargetInfo;
+
+		if (Tag != NAME_None)
+		{
+			DeferredNotifications.RemoveAll([&](const FFlareDeferredNotification& Candidate)
+			{
+				return Candidate.Tag == Tag;
+			});
+		}
+
+		DeferredNotifications.Add(Notification);
+		return;
+	}
+
 	// Notify
 	if(MenuManager->Notify(Title, Info, Tag, Type, Pinned, TargetMenu, TargetInfo))
 	{
@@ -768,6 +793,38 @@ void AFlarePlayerController::Notify(FText Title, FText Info, FName Tag, EFlareNo
 	}
 }
 
+void AFlarePlayerController::BeginDeferredNotifications()
+{
+	DeferNotifications = true;
+}
+
+void AFlarePlayerController::EndDeferredNotifications()
+{
+	DeferNotifications = false;
+
+	TArray<FFlareDeferredNotification> Notifications = DeferredNotifications;
+	DeferredNotifications.Empty();
+
+	for (const FFlareDeferredNotification& Notification : Notifications)
+	{
+		Notify(Notification.Text, Notification.Info, Notification.Tag, Notification.Type, Notification.Pinned, Notification.TargetMenu, Notification.TargetInfo);
+	}
+}
+
+bool AFlarePlayerController::HasDeferredStopNotification() const
+{
+	// Same rule as AFlareMenuManager::Notify
+	for (const FFlareDeferredNotification& Notification : DeferredNotifications)
+	{
+		if (Notification.Type != EFlareNotification::NT_NewQuest)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void AFlarePlayerController::SetupCockpit()
 {
 	if (!CockpitManager)
@@ -15,6 +15,19 @@ class AFlareMenuManager;
 class UFlareCameraShakeCatalog;
 
 
+/** Notification waiting for the end of a batch simulation */
+struct FFlareDeferredNotification
+{
+	FText Text;
+	FText Info;
+	FName Tag;
+	EFlareNotification::Type Type;
+	bool Pinned;
+	EFlareMenu::Type TargetMenu;
+	FFlareMenuParameterData TargetInfo;
+};
+
+
 UCLASS(MinimalAPI)
 class AFlarePlayerController : public APlayerController
 {
@@ -127,6 +140,15 @@ public:
 	/** Show a notification to the user */
 	void Notify(FText Text, FText Info, FName Tag, EFlareNotification::Type Type = EFlareNotification::NT_Info, bool Pinned = false, EFlareMenu::Type TargetMenu = EFlareMenu::MENU_None, FFlareMenuParameterData TargetInfo = FFlareMenuParameterData());
 
+	/** Start queuing notifications instead of showing them */
+	void BeginDeferredNotifications();
+
+	/** Show the queued notifications, one for each tag */
+	void EndDeferredNotifications();
+
+	/** Check if a queued notification will stop fast forward once shown */
+	bool HasDeferredStopNotification() const;
+
 	/** Setup the cockpit */
 	void SetupCockpit();
 
@@ -476,6 +498,10 @@ protected:
 	bool                                     HasCurrentObjective;
 	bool                                     IsBusy;
 
+	// Notifications queued during batch simulation
+	TArray<FFlareDeferredNotification>       DeferredNotifications;
+	bool                                     DeferNotifications;
+
 	FFlareSectorBattleState                  LastBattleState;
 	TMap<UFlareSimulatedSector*, FFlareSectorBattleState> LastSectorBattleStates;
 
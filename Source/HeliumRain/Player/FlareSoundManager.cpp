@@ -287,7 +287,7 @@ void UFlareSoundManager::Update(float DeltaSeconds)
 		int32 EngineCount = 0;
 
 		// Check all engines for engine alpha values
-		TArray<UActorComponent*> Engines = ShipPawn->GetComponentsByClass(UFlareEngine::StaticClass());
+		const TArray<UActorComponent*>& Engines = ShipPawn->GetEngines();
 		for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 		{
 			UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
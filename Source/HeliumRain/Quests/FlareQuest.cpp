@@ -577,32 +577,33 @@ TArray<UFlareQuestCondition*> UFlareQuest::GetCurrentConditions()
 TArray<EFlareQuestCallback::Type> UFlareQuest::GetCurrentCallbacks()
 {
 	TArray<EFlareQuestCallback::Type> Callbacks;
+	UFlareQuestCondition::AddConditionCallbacks(Callbacks, GetCallbackConditions());
+	return Callbacks;
+}
+
+TArray<UFlareQuestCondition*> UFlareQuest::GetCallbackConditions()
+{
+	TArray<UFlareQuestCondition*> Conditions;
 
-	// TODO Cache and return reference
 	switch(QuestStatus)
 	{
 		case EFlareQuestStatus::PENDING:
 			// Use trigger conditions
-			UFlareQuestCondition::AddConditionCallbacks(Callbacks, TriggerCondition->GetAllConditions());
-
-			if (Callbacks.Contains(EFlareQuestCallback::TICK_FLYING))
-			{
-				FLOGV("WARNING: The quest %s need a TICK_FLYING callback as trigger", *GetIdentifier().ToString());
-			}
+			Conditions += TriggerCondition->GetAllConditions();
 			break;
 		case EFlareQuestStatus::AVAILABLE:
 			// Use expiration conditions
-			UFlareQuestCondition::AddConditionCallbacks(Callbacks, ExpirationCondition->GetAllConditions());
+			Conditions += ExpirationCondition->GetAllConditions();
 			break;
 		case EFlareQuestStatus::ONGOING:
 		 {
 			// Use current step conditions
 			if (CurrentStep)
 			{
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetEnableCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetEndCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetFailCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetBlockCondition()->GetAllConditions());
+				Conditions += CurrentStep->GetEnableCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetEndCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetFailCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetBlockCondition()->GetAllConditions();
 			}
 			else
 			{
@@ -615,7 +616,7 @@ TArray<EFlareQuestCallback::Type> UFlareQuest::GetCurrentCallbacks()
 			break;
 	}
 
-	return Callbacks;
+	return Conditions;
 }
 
 void UFlareQuest::OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity)
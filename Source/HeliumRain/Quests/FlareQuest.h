@@ -95,6 +95,9 @@ public:
 
 	virtual TArray<EFlareQuestCallback::Type> GetCurrentCallbacks();
 
+	/** Get the conditions whose callbacks the quest listens to */
+	virtual TArray<UFlareQuestCondition*> GetCallbackConditions();
+
 	virtual void OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity);
 
 	virtual void OnSpacecraftCaptured(UFlareSimulatedSpacecraft* CapturedSpacecraftBefore, UFlareSimulatedSpacecraft* CapturedSpacecraftAfter);
@@ -82,6 +82,29 @@ void UFlareQuestCondition::AddConditionCallbacks(TArray<EFlareQuestCallback::Typ
 	}
 }
 
+const FFlareQuestEventFilter* UFlareQuestCondition::GetEventFilter(EFlareQuestCallback::Type Callback) const
+{
+	return EventFilters.FindByPredicate([=](const FFlareQuestEventFilter& Filter)
+	{
+		return Filter.Callback == Callback;
+	});
+}
+
+void UFlareQuestCondition::SetEventFilter(EFlareQuestCallback::Type Callback, UFlareSimulatedSector* Sector, UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company)
+{
+	EventFilters.RemoveAll([=](const FFlareQuestEventFilter& Filter)
+	{
+		return Filter.Callback == Callback;
+	});
+
+	FFlareQuestEventFilter Filter;
+	Filter.Callback = Callback;
+	Filter.Sector = Sector;
+	Filter.Spacecraft = Spacecraft;
+	Filter.Company = Company;
+	EventFilters.Add(Filter);
+}
+
 void UFlareQuestCondition::AddConditionObjectives(FFlarePlayerObjectiveData* ObjectiveData)
 {
 	FLOG("ERROR: Not implemented AddConditionObjectives")
@@ -356,6 +379,9 @@ void UFlareQuestConditionSectorVisited::Load(UFlareQuest* ParentQuest, UFlareSim
 	LoadInternal(ParentQuest);
 	Callbacks.AddUnique(EFlareQuestCallback::SECTOR_VISITED);
 	Sector = SectorParam;
+
+	// Visiting another sector doesn't change this one
+	SetEventFilter(EFlareQuestCallback::SECTOR_VISITED, Sector, NULL, NULL);
 	if (Sector)
 	{
 		InitialLabel = FText::Format(LOCTEXT("VisitSectorFormat", "Visit the sector \"{0}\""), Sector->GetSectorName());
@@ -1714,6 +1740,7 @@ void UFlareQuestConditionDockAt::Load(UFlareQuest* ParentQuest, UFlareSimulatedS
 	LoadInternal(ParentQuest);
 	Callbacks.AddUnique(EFlareQuestCallback::SHIP_DOCKED);
 	TargetStation = Station;
+	SetEventFilter(EFlareQuestCallback::SHIP_DOCKED, NULL, TargetStation, NULL);
 	TargetShipMatchId = NAME_None;
 	TargetShipSaveId = NAME_None;
 	Completed = false;
@@ -1827,6 +1854,7 @@ void UFlareQuestConditionAtWar::Load(UFlareQuest* ParentQuest, UFlareCompany* Co
 	Callbacks.AddUnique(EFlareQuestCallback::WAR_STATE_CHANGED);
 	TargetCompany1 = Company1;
 	TargetCompany2 = Company2;
+	SetEventFilter(EFlareQuestCallback::WAR_STATE_CHANGED, NULL, NULL, TargetCompany1);
 
 	UFlareCompany* PlayerCompany = GetGame()->GetPC()->GetCompany();
 
@@ -1885,6 +1913,7 @@ void UFlareQuestConditionAtPeace::Load(UFlareQuest* ParentQuest, UFlareCompany*
 	Callbacks.AddUnique(EFlareQuestCallback::WAR_STATE_CHANGED);
 	TargetCompany1 = Company1;
 	TargetCompany2 = Company2;
+	SetEventFilter(EFlareQuestCallback::WAR_STATE_CHANGED, NULL, NULL, TargetCompany1);
 
 	UFlareCompany* PlayerCompany = GetGame()->GetPC()->GetCompany();
 
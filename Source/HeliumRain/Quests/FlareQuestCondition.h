@@ -49,8 +49,13 @@ public:
 	}
 
 	TArray<EFlareQuestCallback::Type> Callbacks;
+
+	TArray<FFlareQuestEventFilter> EventFilters;
 protected:
 
+	/** Only listen to the events of this callback type involving these objects */
+	void SetEventFilter(EFlareQuestCallback::Type Callback, UFlareSimulatedSector* Sector, UFlareSimulatedSpacecraft* Spacecraft, UFlareCompany* Company);
+
 	  void LoadInternal(UFlareQuest* ParentQuest, FName ConditionIdentifier = NAME_None)
 	  {
 		  Identifier = ConditionIdentifier;
@@ -101,6 +106,9 @@ public:
 		return Callbacks;
 	}
 
+	/** Get the objects this condition cares about for a callback type, NULL if any event may change it */
+	const FFlareQuestEventFilter* GetEventFilter(EFlareQuestCallback::Type Callback) const;
+
 	static void AddConditionCallbacks(TArray<EFlareQuestCallback::Type>& Callbacks, const TArray<UFlareQuestCondition*>& Conditions);
 
 	static const FFlareBundle* GetStepConditionBundle(UFlareQuestCondition* Condition, const TArray<FFlareQuestConditionSave>& Data);
@@ -6,6 +6,7 @@
 #include "../Data/FlareQuestCatalogEntry.h"
 #include "../Player/FlarePlayerController.h"
 #include "FlareQuestGenerator.h"
+#include "FlareQuestCondition.h"
 #include "FlareCatalogQuest.h"
 #include "QuestCatalog/FlareTutorialQuest.h"
 #include "QuestCatalog/FlareHistoryQuest.h"
@@ -13,6 +14,8 @@
 #define LOCTEXT_NAMESPACE "FlareQuestManager"
 
 DECLARE_CYCLE_STAT(TEXT("FlareQuestManager OnCallbackEvent"), STAT_FlareQuestManager_OnCallbackEvent, STATGROUP_Flare);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FlareQuestManager Updated quests"), STAT_FlareQuestManager_UpdatedQuests, STATGROUP_Flare);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FlareQuestManager Filtered quests"), STAT_FlareQuestManager_FilteredQuests, STATGROUP_Flare);
 
 
 /*----------------------------------------------------
@@ -302,58 +305,79 @@ void UFlareQuestManager::LoadCallbacks(UFlareQuest* Quest)
 {
 	ClearCallbacks(Quest);
 
-	TArray<EFlareQuestCallback::Type> Callbacks = Quest->GetCurrentCallbacks();
+	// Merge the event filters of all conditions listening to the same callback
+	FFlareQuestSubscriber Subscriptions[EFlareQuestCallback::Num];
+	for (UFlareQuestCondition* Condition : Quest->GetCallbackConditions())
+	{
+		for (EFlareQuestCallback::Type Callback : Condition->GetConditionCallbacks())
+		{
+			FFlareQuestSubscriber& Subscription = Subscriptions[Callback];
+			const FFlareQuestEventFilter* Filter = Condition->GetEventFilter(Callback);
 
-	for (int i = 0; i < Callbacks.Num(); i++)
+			Subscription.Quest = Quest;
+			if (Filter)
+			{
+				Subscription.Filters.Add(*Filter);
+			}
+			else
+			{
+				Subscription.AnyEvent = true;
+			}
+		}
+	}
+
+	if (Quest->GetStatus() == EFlareQuestStatus::PENDING && Subscriptions[EFlareQuestCallback::TICK_FLYING].Quest)
 	{
-		CallbacksMap.FindOrAdd(Callbacks[i]).Add(Quest);
+		FLOGV("WARNING: The quest %s need a TICK_FLYING callback as trigger", *Quest->GetIdentifier().ToString());
+	}
 
-		/*switch (Callbacks[i])
+	for (int32 Callback = 0; Callback < EFlareQuestCallback::Num; Callback++)
+	{
+		if (Subscriptions[Callback].Quest)
 		{
-		case EFlareQuestCallback::FLY_SHIP:
-			FlyShipCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::TICK_FLYING:
-			TickFlyingCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SECTOR_VISITED:
-			SectorVisitedCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SECTOR_ACTIVE:
-			SectorActiveCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SHIP_DOCKED:
-			ShipDockedCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::QUEST:
-			QuestCallback.Add(Quest);
-			break;
-		default:
-			FLOGV("Bad callback type %d for quest %s", (int)(Callbacks[i] + 0), *Quest->GetIdentifier().ToString());
-		}*/
+			CallbackLists[Callback].Add(Subscriptions[Callback]);
+		}
 	}
 }
 
 void UFlareQuestManager::ClearCallbacks(UFlareQuest* Quest)
 {
-	for (auto& Elem : CallbacksMap)
+	for (FFlareQuestCallbackList& List : CallbackLists)
 	{
-		Elem.Value.Remove(Quest);
+		List.Remove(Quest);
 	}
 }
 
-void UFlareQuestManager::OnCallbackEvent(EFlareQuestCallback::Type EventType)
+template <typename HandlerType>
+void UFlareQuestManager::DispatchEvent(EFlareQuestCallback::Type EventType, const FFlareQuestEventInfo& Event, HandlerType Handler)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareQuestManager_OnCallbackEvent);
-	
-	if (CallbacksMap.Contains(EventType))
+
+	// Quest updates may change subscriptions, this list only sees them once dispatched
+	FFlareQuestCallbackList& List = CallbackLists[EventType];
+	List.DispatchDepth++;
+
+	for (int32 SubscriberIndex = 0; SubscriberIndex < List.Subscribers.Num(); SubscriberIndex++)
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EventType];
-		for (UFlareQuest* Quest: Callbacks)
+		UFlareQuest* Quest = List.Subscribers[SubscriberIndex].Quest;
+		if (List.Subscribers[SubscriberIndex].Matches(Event))
 		{
+			Handler(Quest);
 			Quest->UpdateState();
+			INC_DWORD_STAT(STAT_FlareQuestManager_UpdatedQuests);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_FlareQuestManager_FilteredQuests);
 		}
 	}
+
+	List.EndDispatch();
+}
+
+void UFlareQuestManager::OnCallbackEvent(EFlareQuestCallback::Type EventType, const FFlareQuestEventInfo& Event)
+{
+	DispatchEvent(EventType, Event, [](UFlareQuest* Quest) {});
 }
 
 void UFlareQuestManager::OnTick(float DeltaSeconds)
@@ -367,103 +391,91 @@ void UFlareQuestManager::OnTick(float DeltaSeconds)
 
 void UFlareQuestManager::OnFlyShip(AFlareSpacecraft* Ship)
 {
-	OnCallbackEvent(EFlareQuestCallback::FLY_SHIP);
+	FFlareQuestEventInfo Event;
+	Event.Spacecrafts[0] = Ship ? Ship->GetParent() : NULL;
+	OnCallbackEvent(EFlareQuestCallback::FLY_SHIP, Event);
 }
 
 void UFlareQuestManager::OnSectorActivation(UFlareSimulatedSector* Sector)
 {
-	OnCallbackEvent(EFlareQuestCallback::SECTOR_ACTIVE);
+	FFlareQuestEventInfo Event;
+	Event.Sector = Sector;
+	OnCallbackEvent(EFlareQuestCallback::SECTOR_ACTIVE, Event);
 }
 
 void UFlareQuestManager::OnSectorVisited(UFlareSimulatedSector* Sector)
 {
-	OnCallbackEvent(EFlareQuestCallback::SECTOR_VISITED);
+	FFlareQuestEventInfo Event;
+	Event.Sector = Sector;
+	OnCallbackEvent(EFlareQuestCallback::SECTOR_VISITED, Event);
 }
 
 void UFlareQuestManager::OnShipDocked(UFlareSimulatedSpacecraft* Station, UFlareSimulatedSpacecraft* Ship)
 {
-	OnCallbackEvent(EFlareQuestCallback::SHIP_DOCKED);
+	FFlareQuestEventInfo Event;
+	Event.Spacecrafts[0] = Station;
+	Event.Spacecrafts[1] = Ship;
+	OnCallbackEvent(EFlareQuestCallback::SHIP_DOCKED, Event);
 }
 
 void UFlareQuestManager::OnWarStateChanged(UFlareCompany* Company1, UFlareCompany* Company2)
 {
-	OnCallbackEvent(EFlareQuestCallback::WAR_STATE_CHANGED);
+	FFlareQuestEventInfo Event;
+	Event.Companies[0] = Company1;
+	Event.Companies[1] = Company2;
+	OnCallbackEvent(EFlareQuestCallback::WAR_STATE_CHANGED, Event);
 }
 
 void UFlareQuestManager::OnSpacecraftDestroyed(UFlareSimulatedSpacecraft* Spacecraft, bool Uncontrollable, DamageCause Cause)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::SPACECRAFT_DESTROYED))
-	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::SPACECRAFT_DESTROYED];
-		for (UFlareQuest* Quest: Callbacks)
-		{
-			Quest->OnSpacecraftDestroyed(Spacecraft, Uncontrollable, Cause);
-			Quest->UpdateState();
-		}
-	}
+	FFlareQuestEventInfo Event;
+	Event.Spacecrafts[0] = Spacecraft;
 
-	OnCallbackEvent(EFlareQuestCallback::SPACECRAFT_DESTROYED);
+	DispatchEvent(EFlareQuestCallback::SPACECRAFT_DESTROYED, Event, [&](UFlareQuest* Quest)
+	{
+		Quest->OnSpacecraftDestroyed(Spacecraft, Uncontrollable, Cause);
+	});
 }
 
 void UFlareQuestManager::OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::TRADE_DONE))
-	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::TRADE_DONE];
-		for (UFlareQuest* Quest: Callbacks)
-		{
-			Quest->OnTradeDone(SourceSpacecraft, DestinationSpacecraft, Resource, Quantity);
-			Quest->UpdateState();
-		}
-	}
+	FFlareQuestEventInfo Event;
+	Event.Spacecrafts[0] = SourceSpacecraft;
+	Event.Spacecrafts[1] = DestinationSpacecraft;
 
-	OnCallbackEvent(EFlareQuestCallback::TRADE_DONE);
+	DispatchEvent(EFlareQuestCallback::TRADE_DONE, Event, [&](UFlareQuest* Quest)
+	{
+		Quest->OnTradeDone(SourceSpacecraft, DestinationSpacecraft, Resource, Quantity);
+	});
 }
 
 void UFlareQuestManager::OnSpacecraftCaptured(UFlareSimulatedSpacecraft* CapturedSpacecraftBefore, UFlareSimulatedSpacecraft* CapturedSpacecraftAfter)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::SPACECRAFT_CAPTURED))
-	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::SPACECRAFT_CAPTURED];
-		for (UFlareQuest* Quest: Callbacks)
-		{
-			Quest->OnSpacecraftCaptured(CapturedSpacecraftBefore, CapturedSpacecraftAfter);
-			Quest->UpdateState();
-		}
-	}
+	FFlareQuestEventInfo Event;
+	Event.Spacecrafts[0] = CapturedSpacecraftBefore;
+	Event.Spacecrafts[1] = CapturedSpacecraftAfter;
 
-	OnCallbackEvent(EFlareQuestCallback::SPACECRAFT_CAPTURED);
+	DispatchEvent(EFlareQuestCallback::SPACECRAFT_CAPTURED, Event, [&](UFlareQuest* Quest)
+	{
+		Quest->OnSpacecraftCaptured(CapturedSpacecraftBefore, CapturedSpacecraftAfter);
+	});
 }
 
 
 void UFlareQuestManager::OnTravelStarted(UFlareTravel* Travel)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::TRAVEL_STARTED))
+	DispatchEvent(EFlareQuestCallback::TRAVEL_STARTED, FFlareQuestEventInfo(), [&](UFlareQuest* Quest)
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::TRAVEL_STARTED];
-		for (UFlareQuest* Quest: Callbacks)
-		{
-			Quest->OnTravelStarted(Travel);
-			Quest->UpdateState();
-		}
-	}
-
-	OnCallbackEvent(EFlareQuestCallback::SPACECRAFT_CAPTURED);
+		Quest->OnTravelStarted(Travel);
+	});
 }
 
 void UFlareQuestManager::OnEvent(FFlareBundle& Bundle)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::QUEST_EVENT))
+	DispatchEvent(EFlareQuestCallback::QUEST_EVENT, FFlareQuestEventInfo(), [&](UFlareQuest* Quest)
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::QUEST_EVENT];
-		for (UFlareQuest* Quest: Callbacks)
-		{
-			Quest->OnEvent(Bundle);
-			Quest->UpdateState();
-		}
-	}
-
-	OnCallbackEvent(EFlareQuestCallback::SPACECRAFT_CAPTURED);
+		Quest->OnEvent(Bundle);
+	});
 }
 
 
@@ -820,5 +832,106 @@ bool UFlareQuestManager::IsTradeQuestUseStation(UFlareSimulatedSpacecraft* Stati
 }
 
 
+/*----------------------------------------------------
+	Callback lists
+----------------------------------------------------*/
+
+bool FFlareQuestEventFilter::Matches(const FFlareQuestEventInfo& Event) const
+{
+	// Unknown event objects can't rule a quest out
+	if (Sector && Event.Sector && Sector != Event.Sector)
+	{
+		return false;
+	}
+
+	if (Spacecraft && (Event.Spacecrafts[0] || Event.Spacecrafts[1])
+	 && Spacecraft != Event.Spacecrafts[0] && Spacecraft != Event.Spacecrafts[1])
+	{
+		return false;
+	}
+
+	if (Company && (Event.Companies[0] || Event.Companies[1])
+	 && Company != Event.Companies[0] && Company != Event.Companies[1])
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool FFlareQuestSubscriber::Matches(const FFlareQuestEventInfo& Event) const
+{
+	if (AnyEvent)
+	{
+		return true;
+	}
+
+	for (const FFlareQuestEventFilter& Filter : Filters)
+	{
+		if (Filter.Matches(Event))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FFlareQuestCallbackList::Add(const FFlareQuestSubscriber& Subscriber)
+{
+	if (DispatchDepth > 0)
+	{
+		FFlareQuestSubscriberChange Change;
+		Change.IsRemoval = false;
+		Change.Subscriber = Subscriber;
+		PendingChanges.Add(Change);
+	}
+	else
+	{
+		Subscribers.Add(Subscriber);
+	}
+}
+
+void FFlareQuestCallbackList::Remove(UFlareQuest* Quest)
+{
+	if (DispatchDepth > 0)
+	{
+		FFlareQuestSubscriberChange Change;
+		Change.IsRemoval = true;
+		Change.Subscriber.Quest = Quest;
+		PendingChanges.Add(Change);
+	}
+	else
+	{
+		Subscribers.RemoveAll([=](const FFlareQuestSubscriber& Subscriber)
+		{
+			return Subscriber.Quest == Quest;
+		});
+	}
+}
+
+void FFlareQuestCallbackList::EndDispatch()
+{
+	DispatchDepth--;
+
+	if (DispatchDepth == 0 && PendingChanges.Num())
+	{
+		TArray<FFlareQuestSubscriberChange> Changes = MoveTemp(PendingChanges);
+		PendingChanges.Reset();
+
+		for (const FFlareQuestSubscriberChange& Change : Changes)
+		{
+			if (Change.IsRemoval)
+			{
+				Remove(Change.Subscriber.Quest);
+			}
+			else
+			{
+				Add(Change.Subscriber);
+			}
+		}
+	}
+}
+
 
 #undef LOCTEXT_NAMESPACE
@@ -9,6 +9,8 @@ class AFlareSpacecraft;
 class UFlareQuestGenerator;
 struct FFlareQuestDescription;
 class UFlareSimulatedSpacecraft;
+class UFlareSimulatedSector;
+class UFlareCompany;
 
 /** Quest action type */
 UENUM()
@@ -44,9 +46,91 @@ namespace EFlareQuestCallback
 		SPACECRAFT_CAPTURED, // Trig when a spacecraft is captured
 		TRAVEL_STARTED, // Trig when a fleet start a travel
 		QUEST_EVENT, // Trig when a quest event is send
+		Num
 	};
 }
 
+/** Objects involved in a quest callback event, NULL when unknown */
+struct FFlareQuestEventInfo
+{
+	FFlareQuestEventInfo()
+		: Sector(NULL)
+	{
+		Spacecrafts[0] = Spacecrafts[1] = NULL;
+		Companies[0] = Companies[1] = NULL;
+	}
+
+	UFlareSimulatedSector*                   Sector;
+	UFlareSimulatedSpacecraft*               Spacecrafts[2];
+	UFlareCompany*                           Companies[2];
+};
+
+/** Objects a quest condition cares about for a callback type, NULL fields match any object */
+struct FFlareQuestEventFilter
+{
+	FFlareQuestEventFilter()
+		: Callback(EFlareQuestCallback::Num)
+		, Sector(NULL)
+		, Spacecraft(NULL)
+		, Company(NULL)
+	{}
+
+	/** Check if an event involves these objects */
+	bool Matches(const FFlareQuestEventInfo& Event) const;
+
+	EFlareQuestCallback::Type                Callback;
+	UFlareSimulatedSector*                   Sector;
+	UFlareSimulatedSpacecraft*               Spacecraft;
+	UFlareCompany*                           Company;
+};
+
+/** Quest listening to a callback type */
+struct FFlareQuestSubscriber
+{
+	FFlareQuestSubscriber()
+		: Quest(NULL)
+		, AnyEvent(false)
+	{}
+
+	/** Check if the quest needs to be updated for this event */
+	bool Matches(const FFlareQuestEventInfo& Event) const;
+
+	UFlareQuest*                             Quest;
+
+	// Set if one of the quest conditions has no filter for this callback type
+	bool                                     AnyEvent;
+	TArray<FFlareQuestEventFilter>           Filters;
+};
+
+/** Subscription change delayed by a dispatch */
+struct FFlareQuestSubscriberChange
+{
+	bool                                     IsRemoval;
+	FFlareQuestSubscriber                    Subscriber;
+};
+
+/** Quests listening to a callback type. Changes made while the callback is dispatched are applied after it. */
+struct FFlareQuestCallbackList
+{
+	FFlareQuestCallbackList()
+		: DispatchDepth(0)
+	{}
+
+	/** Subscribe a quest */
+	void Add(const FFlareQuestSubscriber& Subscriber);
+
+	/** Unsubscribe a quest */
+	void Remove(UFlareQuest* Quest);
+
+	/** End a dispatch, applying the delayed changes once no dispatch is running */
+	void EndDispatch();
+
+	TArray<FFlareQuestSubscriber>            Subscribers;
+
+	TArray<FFlareQuestSubscriberChange>      PendingChanges;
+	int32                                    DispatchDepth;
+};
+
 /** Quest current step status save data */
 USTRUCT()
 struct FFlareQuestConditionSave
@@ -56,6 +140,7 @@ struct FFlareQuestConditionSave
 	UPROPERTY(VisibleAnywhere, Category = Save)
 	FName ConditionIdentifier;
 
+	UPROPERTY(VisibleAnywhere, Category = Save)
 	FFlareBundle Data;
 };
 
@@ -101,6 +186,8 @@ struct FFlareGeneratedQuestSave
 
 	UPROPERTY(VisibleAnywhere, Category = Save)
 	FName QuestClass;
+
+	UPROPERTY(VisibleAnywhere, Category = Save)
 	FFlareBundle Data;
 };
 
@@ -188,7 +275,7 @@ public:
 
 	virtual void ClearCallbacks(UFlareQuest* Quest);
 
-	void OnCallbackEvent(EFlareQuestCallback::Type EventType);
+	void OnCallbackEvent(EFlareQuestCallback::Type EventType, const FFlareQuestEventInfo& Event = FFlareQuestEventInfo());
 
 	virtual void OnFlyShip(AFlareSpacecraft* Ship);
 
@@ -228,6 +315,10 @@ public:
 
 protected:
 
+	/** Update the quests listening to this event, calling Handler on each of them first */
+	template <typename HandlerType>
+	void DispatchEvent(EFlareQuestCallback::Type EventType, const FFlareQuestEventInfo& Event, HandlerType Handler);
+
    /*----------------------------------------------------
 	   Protected data
    ----------------------------------------------------*/
@@ -249,7 +340,7 @@ protected:
 	
 	UFlareQuest*			                 SelectedQuest;
 
-	TMap<EFlareQuestCallback::Type, TArray<UFlareQuest*>> CallbacksMap;
+	FFlareQuestCallbackList                  CallbackLists[EFlareQuestCallback::Num];
 
 	FFlareQuestSave			                 QuestData;
 
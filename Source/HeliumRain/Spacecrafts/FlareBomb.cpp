@@ -4,6 +4,7 @@
 
 #include "../Game/FlareAsteroid.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareActorPool.h"
 #include "../Game/FlareGameTools.h"
 
 #include "../Player/FlarePlayerController.h"
@@ -57,6 +58,9 @@ void AFlareBomb::Initialize(const FFlareBombSave* Data, UFlareWeapon* Weapon)
 {
 	ParentWeapon = Weapon;
 	WeaponDescription = Weapon->GetDescription();
+	TargetSpacecraft = NULL;
+	Paused = false;
+	BombLockedInCollision = 0;
 
 	// Get the power from description
 	if (WeaponDescription)
@@ -85,7 +89,10 @@ void AFlareBomb::Initialize(const FFlareBombSave* Data, UFlareWeapon* Weapon)
 		BombData.Dropped = false;
 		BombData.Locked = false;
 		BombData.LifeTime = 0;
+		BombData.BurnDuration = 0;
 		BombData.DropParentDistance = 0;
+		BombData.AttachTarget = NAME_None;
+		BombData.AimTargetSpacecraft = NAME_None;
 		BombData.Identifier = Weapon->GetSpacecraft()->GetGame()->GenerateIdentifier(TEXT("bomb"));
 	}
 
@@ -576,7 +583,7 @@ void AFlareBomb::OnBombDetonated(AFlareSpacecraft* HitSpacecraft, UFlareSpacecra
 			ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector()->UnregisterBomb(this);
 		}
 		CombatLog::BombDestroyed(GetIdentifier());
-		Destroy();
+		Recycle();
 	}
 }
 
@@ -593,6 +600,32 @@ void AFlareBomb::AttachBomb(AFlareSpacecraft* HitSpacecraft)
 	}
 }
 
+void AFlareBomb::Recycle()
+{
+	AFlareGame* Game = Cast<AFlareGame>(GetWorld()->GetAuthGameMode());
+	FCHECK(Game);
+
+	if (Game->GetActorPool()->IsParked(this))
+	{
+		return;
+	}
+
+	// Forget the collision exceptions set up by the weapon
+	if (ParentWeapon)
+	{
+		ParentWeapon->MoveIgnoreActors.Remove(this);
+		if (ParentWeapon->GetSpacecraft())
+		{
+			ParentWeapon->GetSpacecraft()->Airframe->IgnoreActorWhenMoving(this, false);
+		}
+	}
+	BombComp->ClearMoveIgnoreActors();
+	ParentWeapon = NULL;
+	TargetSpacecraft = NULL;
+
+	Game->GetActorPool()->ReleaseBomb(this);
+}
+
 FFlareBombSave* AFlareBomb::Save()
 {
 	// Physical data
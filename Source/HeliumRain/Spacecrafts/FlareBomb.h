@@ -110,6 +110,9 @@ public:
 	/** Attach bomb */
 	void AttachBomb(AFlareSpacecraft* HitSpacecraft);
 
+	/** Return the bomb to the actor pool */
+	void Recycle();
+
 	/** Save the bomb to a save file */
 	virtual FFlareBombSave* Save();
 
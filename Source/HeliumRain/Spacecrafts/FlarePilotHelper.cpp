@@ -24,10 +24,16 @@ bool PilotHelper::CheckFriendlyFire(UFlareSector* Sector, UFlareCompany* MyCompa
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_CheckFriendlyFire);
 
+	// Only spacecrafts that can reach the ammo before MaxDelay are relevant
+	const FFlareSectorBroadphase& Broadphase = Sector->GetBroadphase();
+	float MaxReachDistance = (AmmoVelocity + FireBaseVelocity.Size() + Broadphase.GetMaxSpeed()) * MaxDelay;
+	TArray<int32> Candidates;
+	Broadphase.QueryRadius(FireBaseLocation, MaxReachDistance, EFlareBroadphaseType::Spacecraft, Candidates);
+
 	//FLOG("CheckFriendlyFire");
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+	for (int32 CandidateIndex : Candidates)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Broadphase.GetEntry(CandidateIndex).Actor);
 
 		if (SpacecraftCandidate)
 		{
@@ -83,64 +89,7 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_AnticollisionCorrection);
 
-	typedef TPair<AActor*, FVector> TFlareCollisionCandidate;
-
 	UFlareSector* ActiveSector = Ship->GetGame()->GetActiveSector();
-	TArray<TFlareCollisionCandidate> Candidates;
-	TFlareCollisionCandidate Candidate;
-
-	// Select dangerous ships
-	for (auto SpacecraftCandidate : ActiveSector->GetSpacecrafts())
-	{
-		if (SpacecraftCandidate != Ship
-		 && SpacecraftCandidate != SpacecraftToIgnore
-		 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
-		 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
-		 && !(Ship->GetSize() == EFlarePartSize::L
-			  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
-			  && IsShipDangerous(SpacecraftCandidate)
-			  && Ship->GetWarState(SpacecraftCandidate->GetCompany()) == EFlareHostility::Hostile))
-		{
-			Candidate.Key = SpacecraftCandidate;
-			Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
-
-	// Select dangerous asteroids
-	for (auto AsteroidCandidate : ActiveSector->GetAsteroids())
-	{
-		Candidate.Key = AsteroidCandidate;
-		Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
-		Candidates.Add(Candidate);
-	}
-
-	// Select dangerous meteorites
-	for (auto MeteoriteCandidate : ActiveSector->GetMeteorites())
-	{
-		if(!MeteoriteCandidate->IsBroken())
-		{
-			Candidate.Key = MeteoriteCandidate;
-			Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
-
-	// Select dangerous colliders
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(Ship->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (auto ColliderCandidate : ColliderActorList)
-	{
-		Candidate.Key = Cast<AFlareCollider>(ColliderCandidate);
-		Candidate.Value = FVector::ZeroVector;
-		Candidates.Add(Candidate);
-	}
-
-	// No candidate found, return
-	if (Candidates.Num() == 0)
-	{
-		return false;
-	}
 
 	// Input data for danger processing
 	FBox ShipBox = Ship->GetComponentsBoundingBox();
@@ -152,13 +101,43 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 	// Output data
 	MostDangerousCandidateActor = NULL;
 
+	// Find nearby candidates
+	const FFlareSectorBroadphase& Broadphase = ActiveSector->GetBroadphase();
+	TArray<int32> Candidates;
+	Broadphase.QueryRadius(CurrentLocation, MaxRelevanceDistance, EFlareBroadphaseType::All, Candidates);
+
 	// Process all candidates
-	for (auto SelectedCandidate : Candidates)
+	for (int32 CandidateIndex : Candidates)
 	{
-		if ((SelectedCandidate.Key->GetActorLocation() - CurrentLocation).Size() < MaxRelevanceDistance)
+		const FFlareBroadphaseEntry& Candidate = Broadphase.GetEntry(CandidateIndex);
+
+		// Ignore harmless ships
+		if (Candidate.Type == EFlareBroadphaseType::Spacecraft)
+		{
+			AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Candidate.Actor);
+			if (SpacecraftCandidate == Ship
+			 || SpacecraftCandidate == SpacecraftToIgnore
+			 || Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
+			 || Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
+			 || (Ship->GetSize() == EFlarePartSize::L
+				  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
+				  && IsShipDangerous(SpacecraftCandidate)
+				  && Ship->GetWarState(SpacecraftCandidate->GetCompany()) == EFlareHostility::Hostile))
+			{
+				continue;
+			}
+		}
+
+		// Ignore broken meteorites
+		else if (Candidate.Type == EFlareBroadphaseType::Meteorite && Cast<AFlareMeteorite>(Candidate.Actor)->IsBroken())
+		{
+			continue;
+		}
+
+		if ((Candidate.Actor->GetActorLocation() - CurrentLocation).Size() < MaxRelevanceDistance)
 		{
 			CheckRelativeDangerosity(MostDangerousCandidateActor, MostDangerousLocation, MostDangerousTimeToHit, MostDangerousInterceptDepth,
-									 SelectedCandidate.Key, CurrentLocation, CurrentSize, SelectedCandidate.Value, CurrentVelocity, SpeedLimit);
+									 Candidate.Actor, CurrentLocation, CurrentSize, Candidate.Velocity, CurrentVelocity, SpeedLimit);
 		}
 	}
 
@@ -568,7 +547,7 @@ UFlareSpacecraftComponent* PilotHelper::GetBestTargetComponent(AFlareSpacecraft*
 
 	TArray<UFlareSpacecraftComponent*> ComponentSelection;
 
-	TArray<UActorComponent*> Components = TargetSpacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	const TArray<UActorComponent*>& Components = TargetSpacecraft->GetSpacecraftComponents();
 	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
 	{
 		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
@@ -3,6 +3,7 @@
 #include "../Flare.h"
 #include "FlareSpacecraft.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareActorPool.h"
 #include "../Game/FlareGameTypes.h"
 #include "../Player/FlarePlayerController.h"
 #include "Components/DecalComponent.h"
@@ -74,7 +75,9 @@ void AFlareShell::Initialize(UFlareWeapon* Weapon, const FFlareSpacecraftCompone
 			true);
 	}
 
-	SetLifeSpan(ShellDescription->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / ShellVelocity.Size()); // 10km
+	// Pooled shells don't use the actor life span
+	ShellLifeSpan = ShellDescription->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / ShellVelocity.Size(); // 10km
+	ShellRemainingLife = ShellLifeSpan;
 	ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector()->RegisterShell(this);
 	PC = ParentWeapon->GetSpacecraft()->GetGame()->GetPC();
 
@@ -84,6 +87,14 @@ void AFlareShell::Initialize(UFlareWeapon* Weapon, const FFlareSpacecraftCompone
 void AFlareShell::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
+
+	// Out of range
+	ShellRemainingLife -= DeltaSeconds;
+	if (ShellRemainingLife <= 0)
+	{
+		Recycle();
+		return;
+	}
 	
 	FVector ActorLocation = GetActorLocation();
 	FVector NextActorLocation = ActorLocation + ShellVelocity * DeltaSeconds;
@@ -95,7 +106,7 @@ void AFlareShell::Tick(float DeltaSeconds)
 	float MinScale = 0.1f;
 	if(PC->GetShipPawn())
 	{
-		float LifeRatio = GetLifeSpan() / InitialLifeSpan;
+		float LifeRatio = ShellRemainingLife / ShellLifeSpan;
 
 		float LifeRatioScale = 1.f;
 
@@ -142,9 +153,15 @@ void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
 	FVector Center = (NextActorLocation + ActorLocation) / 2;
 	float NearThresoldSquared = FMath::Square(100000); // 1km
 	UFlareSector* Sector = ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector();
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+
+	// Only consider ships near the shell
+	const FFlareSectorBroadphase& Broadphase = Sector->GetBroadphase();
+	TArray<int32> Candidates;
+	Broadphase.QueryRadius(Center, 100000, EFlareBroadphaseType::Spacecraft, Candidates);
+
+	for (int32 CandidateIndex : Candidates)
 	{
-		AFlareSpacecraft* ShipCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* ShipCandidate = Cast<AFlareSpacecraft>(Broadphase.GetEntry(CandidateIndex).Actor);
 
 
 		if (ShipCandidate == ParentWeapon->GetSpacecraft())
@@ -351,7 +368,7 @@ void AFlareShell::OnImpact(const FHitResult& HitResult, const FVector& HitVeloci
 
 	if (DestroyProjectile)
 	{
-		Destroy();
+		Recycle();
 	}
 }
 
@@ -474,7 +491,7 @@ void AFlareShell::DetonateAt(FVector DetonatePoint)
 		}
 
 	}
-	Destroy();
+	Recycle();
 }
 
 float AFlareShell::ApplyDamage(AActor *ActorToDamage, UPrimitiveComponent* HitComponent, FVector ImpactLocation,  FVector ImpactAxis,  FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType)
@@ -651,6 +668,32 @@ void AFlareShell::Destroyed()
 	}
 }
 
+void AFlareShell::Recycle()
+{
+	AFlareGame* Game = Cast<AFlareGame>(GetWorld()->GetAuthGameMode());
+	FCHECK(Game);
+
+	if (Game->GetActorPool()->IsParked(this))
+	{
+		return;
+	}
+
+	UFlareSector* Sector = Game->GetActiveSector();
+	if (Sector)
+	{
+		Sector->UnregisterShell(this);
+	}
+
+	// Flight effects are spawned again by the next shot
+	if (FlightEffects)
+	{
+		FlightEffects->DestroyComponent();
+		FlightEffects = NULL;
+	}
+
+	Game->GetActorPool()->ReleaseShell(this);
+}
+
 void AFlareShell::SetFuzeTimer(float TargetSecureTime, float TargetActiveTime)
 {
 	SecureTime = TargetSecureTime;
@@ -35,6 +35,9 @@ public:
 
 	virtual void Destroyed() override;
 
+	/** Return the shell to the actor pool */
+	void Recycle();
+
 	virtual void SetFuzeTimer(float TargetSecureTime, float TargetActiveTime);
 
 	virtual void CheckFuze(FVector ActorLocation, FVector NextActorLocation);
@@ -84,6 +87,8 @@ protected:
 	const FFlareSpacecraftComponentDescription*    ShellDescription;
 	FVector                                        LastLocation;	
 	float                                          ShellMass;
+	float                                          ShellLifeSpan;
+	float                                          ShellRemainingLife;
 	bool                                           TracerShell;
 	bool                                           Armed;
 	float                                          MinEffectiveDistance;
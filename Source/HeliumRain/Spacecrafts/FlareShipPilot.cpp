@@ -1379,11 +1379,7 @@ FVector UFlareShipPilot::ExitAvoidance(AFlareSpacecraft* TargetShip, FVector Ini
 
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
-
-
-		FVector Acceleration = Ship->GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / Ship->GetSpacecraftMass();
+		FVector Acceleration = Ship->GetNavigationSystem()->GetTotalMaxThrustInAxis(Ship->GetEngines(), CurrentVelocityAxis, false) / Ship->GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, CurrentVelocityAxis));
 
 		TimeToStop= (CurrentVelocity.Size() / (AccelerationInAngleAxis));
@@ -1575,7 +1571,7 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestShip(bool IgnoreDockingShip) const
 
 FVector UFlareShipPilot::GetAngularVelocityToAlignAxis(FVector LocalShipAxis, FVector TargetAxis, FVector TargetAngularVelocity, float DeltaSeconds) const
 {
-	TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Ship->GetEngines();
 
 	FVector AngularVelocity = Ship->Airframe->GetPhysicsAngularVelocity();
 	FVector WorldShipAxis = Ship->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
@@ -38,6 +38,7 @@ UFlareSimulatedSpacecraft::UFlareSimulatedSpacecraft(const FObjectInitializer& O
 	: Super(ObjectInitializer)
 {
 	ActiveSpacecraft = NULL;
+	SaveDirty = true;
 }
 
 
@@ -45,6 +46,7 @@ void UFlareSimulatedSpacecraft::Load(const FFlareSpacecraftSave& Data)
 {
 	Game = Cast<UFlareCompany>(GetOuter())->GetGame();
 	SpacecraftData = Data;
+	SaveDirty = true;
 
 	// Load spacecraft description
 	SpacecraftDescription = Game->GetSpacecraftCatalog()->Get(Data.Identifier);
@@ -159,9 +161,16 @@ FFlareSpacecraftSave* UFlareSimulatedSpacecraft::Save()
 		GetActive()->Save();
 	}
 
+	SaveDirty = false;
 	return &SpacecraftData;
 }
 
+bool UFlareSimulatedSpacecraft::IsSaveDirty() const
+{
+	// Spacecrafts in the active sector change every frame
+	return SaveDirty || IsActive() || (CurrentSector && CurrentSector->IsActive());
+}
+
 
 UFlareCompany* UFlareSimulatedSpacecraft::GetCompany() const
 {
@@ -212,6 +221,8 @@ UFlareSimulatedSpacecraftWeaponsSystem* UFlareSimulatedSpacecraft::GetWeaponsSys
 
 void UFlareSimulatedSpacecraft::SetSpawnMode(EFlareSpawnMode::Type SpawnMode)
 {
+	MarkSaveDirty();
+
 	SpacecraftData.SpawnMode = SpawnMode;
 }
 
@@ -257,6 +268,8 @@ bool UFlareSimulatedSpacecraft::CanBeFlown(FText& OutInfo) const
 
 void UFlareSimulatedSpacecraft::SetCurrentSector(UFlareSimulatedSector* Sector)
 {
+	MarkSaveDirty();
+
 	CurrentSector = Sector;
 
 	// Mark the sector as visited
@@ -429,6 +442,8 @@ void UFlareSimulatedSpacecraft::LockResources()
 
 void UFlareSimulatedSpacecraft::SetAsteroidData(FFlareAsteroidSave* Data)
 {
+	MarkSaveDirty();
+
 	SpacecraftData.AsteroidData.Identifier = Data->Identifier;
 	SpacecraftData.AsteroidData.AsteroidMeshID = Data->AsteroidMeshID;
 	SpacecraftData.AsteroidData.Scale = Data->Scale;
@@ -438,6 +453,8 @@ void UFlareSimulatedSpacecraft::SetAsteroidData(FFlareAsteroidSave* Data)
 
 void UFlareSimulatedSpacecraft::SetActorAttachment(FName ActorName)
 {
+	MarkSaveDirty();
+
 	FLOGV("UFlareSimulatedSpacecraft::SetActorAttachment : %s will attach to %s",
 		*GetImmatriculation().ToString(), *ActorName.ToString());
 
@@ -446,12 +463,20 @@ void UFlareSimulatedSpacecraft::SetActorAttachment(FName ActorName)
 
 void UFlareSimulatedSpacecraft::SetDynamicComponentState(FName Identifier, float Progress)
 {
+	if (SpacecraftData.DynamicComponentStateIdentifier == Identifier && SpacecraftData.DynamicComponentStateProgress == Progress)
+	{
+		return;
+	}
+
+	MarkSaveDirty();
 	SpacecraftData.DynamicComponentStateIdentifier = Identifier;
 	SpacecraftData.DynamicComponentStateProgress = Progress;
 }
 
 void UFlareSimulatedSpacecraft::Upgrade()
 {
+	MarkSaveDirty();
+
 	FLOGV("UFlareSimulatedSpacecraft::Upgrade %s to level %d", *GetImmatriculation().ToString(), SpacecraftData.Level+1);
 
 	SpacecraftData.Level++;
@@ -459,6 +484,7 @@ void UFlareSimulatedSpacecraft::Upgrade()
 	SpacecraftData.CargoBackup = SpacecraftData.Cargo;
 	SpacecraftData.Cargo.Empty();
 	Load(SpacecraftData);
+	Game->GetGameWorld()->GetResourceStatsCache().Invalidate(GetCurrentSector());
 
 	if(GetCompany() == Game->GetPC()->GetCompany())
 	{
@@ -472,6 +498,8 @@ void UFlareSimulatedSpacecraft::Upgrade()
 
 void UFlareSimulatedSpacecraft::ForceUndock()
 {
+	MarkSaveDirty();
+
 	SpacecraftData.DockedTo = NAME_None;
 	SpacecraftData.DockedAt = -1;
 }
@@ -503,17 +531,26 @@ void UFlareSimulatedSpacecraft::SetTrading(bool Trading)
 			Data);
 	}
 
+	MarkSaveDirty();
 	SpacecraftData.IsTrading = Trading;
 }
 
 void UFlareSimulatedSpacecraft::SetIntercepted(bool Intercepted)
 {
-	SpacecraftData.IsIntercepted = Intercepted;
+	if (SpacecraftData.IsIntercepted != Intercepted)
+	{
+		MarkSaveDirty();
+		SpacecraftData.IsIntercepted = Intercepted;
+	}
 }
 
 void UFlareSimulatedSpacecraft::SetReserve(bool InReserve)
 {
-	SpacecraftData.IsReserve = InReserve;
+	if (SpacecraftData.IsReserve != InReserve)
+	{
+		MarkSaveDirty();
+		SpacecraftData.IsReserve = InReserve;
+	}
 }
 
 
@@ -525,6 +562,8 @@ void UFlareSimulatedSpacecraft::Repair()
 		return;
 	}
 
+	MarkSaveDirty();
+
 	UFlareSpacecraftComponentsCatalog* Catalog = GetGame()->GetShipPartsCatalog();
 
 	float SpacecraftPreciseCurrentNeededFleetSupply = 0;
@@ -583,6 +622,8 @@ void UFlareSimulatedSpacecraft::Repair()
 
 void UFlareSimulatedSpacecraft::RecoveryRepair()
 {
+	MarkSaveDirty();
+
 	SpacecraftData.RepairStock = 0;
 
 
@@ -620,6 +661,7 @@ void UFlareSimulatedSpacecraft::Stabilize()
 {
 	if(!GetDamageSystem()->IsUncontrollable())
 	{
+		MarkSaveDirty();
 		SpacecraftData.LinearVelocity = FVector::ZeroVector;
 		SpacecraftData.AngularVelocity = FVector::ZeroVector;
 
@@ -642,6 +684,8 @@ void UFlareSimulatedSpacecraft::Refill()
 		return;
 	}
 
+	MarkSaveDirty();
+
 	UFlareSpacecraftComponentsCatalog* Catalog = GetGame()->GetShipPartsCatalog();
 	float SpacecraftPreciseCurrentNeededFleetSupply = 0;
 
@@ -706,12 +750,14 @@ void UFlareSimulatedSpacecraft::SetHarpooned(UFlareCompany* OwnerCompany)
 	if (OwnerCompany) {
 		if (SpacecraftData.HarpoonCompany != OwnerCompany->GetIdentifier())
 		{
+			MarkSaveDirty();
 			CombatLog::SpacecraftHarpooned(this, OwnerCompany);
 			SpacecraftData.HarpoonCompany  = OwnerCompany->GetIdentifier();
 		}
 	}
-	else
+	else if (SpacecraftData.HarpoonCompany != NAME_None)
 	{
+		MarkSaveDirty();
 		SpacecraftData.HarpoonCompany = NAME_None;
 	}
 }
@@ -725,6 +771,7 @@ void UFlareSimulatedSpacecraft::RemoveCapturePoint(FName CompanyIdentifier, int3
 {
 	if(SpacecraftData.CapturePoints.Contains(CompanyIdentifier))
 	{
+		MarkSaveDirty();
 		int32 CurrentCapturePoint = SpacecraftData.CapturePoints[CompanyIdentifier];
 		if(CapturePoint >= CurrentCapturePoint)
 		{
@@ -767,6 +814,8 @@ void UFlareSimulatedSpacecraft::ResetCapture(UFlareCompany* Company)
 
 bool UFlareSimulatedSpacecraft::TryCapture(UFlareCompany* Company, int32 CapturePoint)
 {
+	MarkSaveDirty();
+
 	int32 CurrentCapturePoint = 0;
 	FName CompanyIdentifier = Company->GetIdentifier();
 	if (SpacecraftData.CapturePoints.Contains(CompanyIdentifier))
@@ -795,7 +844,6 @@ bool UFlareSimulatedSpacecraft::TryCapture(UFlareCompany* Company, int32 Capture
 
 bool UFlareSimulatedSpacecraft::UpgradePart(FFlareSpacecraftComponentDescription* NewPartDesc, int32 WeaponGroupIndex)
 {
-
 	UFlareSpacecraftComponentsCatalog* Catalog = Game->GetPC()->GetGame()->GetShipPartsCatalog();
 	int32 TransactionCost = 0;
 
@@ -833,6 +881,8 @@ bool UFlareSimulatedSpacecraft::UpgradePart(FFlareSpacecraftComponentDescription
 					return false;
 				}
 			}
+
+			MarkSaveDirty();
 			SpacecraftData.Components[i].ComponentIdentifier = NewPartDesc->Identifier;
 			SpacecraftData.Components[i].Weapon.FiredAmmo = 0;
 			GetDamageSystem()->SetDamageDirty(ComponentDescription);
@@ -906,6 +956,8 @@ void UFlareSimulatedSpacecraft::FinishConstruction()
 		return;
 	}
 
+	MarkSaveDirty();
+
 	SpacecraftData.IsUnderConstruction = false;
 	SpacecraftData.Cargo = SpacecraftData.CargoBackup;
 	Load(SpacecraftData);
@@ -920,11 +972,15 @@ void UFlareSimulatedSpacecraft::FinishConstruction()
 
 void UFlareSimulatedSpacecraft::OrderRepairStock(float FS)
 {
+	MarkSaveDirty();
+
 	SpacecraftData.RepairStock += FS;
 }
 
 void UFlareSimulatedSpacecraft::OrderRefillStock(float FS)
 {
+	MarkSaveDirty();
+
 	SpacecraftData.RefillStock += FS;
 }
 
@@ -988,9 +1044,11 @@ bool UFlareSimulatedSpacecraft::ShipyardOrderShip(UFlareCompany* OrderCompany, F
 	newOrder.Company = OrderCompany->GetIdentifier();
 	newOrder.AdvancePayment = ShipPrice;
 
+	MarkSaveDirty();
 	SpacecraftData.ShipyardOrderQueue.Add(newOrder);
 
 	UpdateShipyardProduction();
+	GetGame()->GetGameWorld()->InvalidateIncomingEvents();
 
 	if (OrderCompany == Game->GetPC()->GetCompany())
 	{
@@ -1023,6 +1081,8 @@ void UFlareSimulatedSpacecraft::CancelShipyardOrder(int32 OrderIndex)
 		return;
 	}
 
+	MarkSaveDirty();
+
 	FFlareShipyardOrderSave Order = SpacecraftData.ShipyardOrderQueue[OrderIndex];
 
 	UFlareCompany* Company = GetGame()->GetGameWorld()->FindCompany(Order.Company);
@@ -1037,9 +1097,10 @@ void UFlareSimulatedSpacecraft::CancelShipyardOrder(int32 OrderIndex)
 	SpacecraftData.ShipyardOrderQueue.RemoveAt(OrderIndex);
 
 	UpdateShipyardProduction();
+	GetGame()->GetGameWorld()->InvalidateIncomingEvents();
 }
 
-TArray<FFlareShipyardOrderSave>& UFlareSimulatedSpacecraft::GetShipyardOrderQueue()
+const TArray<FFlareShipyardOrderSave>& UFlareSimulatedSpacecraft::GetShipyardOrderQueue() const
 {
 	return SpacecraftData.ShipyardOrderQueue;
 }
@@ -1169,6 +1230,11 @@ void UFlareSimulatedSpacecraft::UpdateShipyardProduction()
 		Index++;
 	}
 
+	if (IndexToRemove.Num() > 0)
+	{
+		MarkSaveDirty();
+	}
+
 	for (int i = IndexToRemove.Num()-1 ; i >= 0; --i)
 	{
 		SpacecraftData.ShipyardOrderQueue.RemoveAt(IndexToRemove[i]);
@@ -1371,6 +1437,8 @@ bool UFlareSimulatedSpacecraft::IsAllowExternalOrder()
 
 void UFlareSimulatedSpacecraft::SetAllowExternalOrder(bool Allow)
 {
+	MarkSaveDirty();
+
 	SpacecraftData.AllowExternalOrder = Allow;
 }
 
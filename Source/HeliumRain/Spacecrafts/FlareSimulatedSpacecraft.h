@@ -28,6 +28,15 @@ public:
 	/** Save the ship to a save file */
 	virtual FFlareSpacecraftSave* Save();
 
+	/** Flag the save data as outdated, so that the next world save rewrites it */
+	inline void MarkSaveDirty()
+	{
+		SaveDirty = true;
+	}
+
+	/** Check if the ship changed since it was last saved */
+	bool IsSaveDirty() const;
+
 	/** Get the parent company */
 	virtual UFlareCompany* GetCompany() const;
 
@@ -161,7 +170,7 @@ public:
 
 	void CancelShipyardOrder(int32 OrderIndex);
 
-	TArray<FFlareShipyardOrderSave>& GetShipyardOrderQueue();
+	const TArray<FFlareShipyardOrderSave>& GetShipyardOrderQueue() const;
 
 	TArray<FFlareShipyardOrderSave> GetOngoingProductionList();
 
@@ -207,6 +216,7 @@ protected:
 
 	UFlareFleet*                  CurrentFleet;
 	UFlareSimulatedSector*        CurrentSector;
+	bool                          SaveDirty;
 
 	// Systems
 	UPROPERTY()
@@ -173,14 +173,10 @@ void AFlareSpacecraft::Tick(float DeltaSeconds)
 		}
 
 		// Lights
-		TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
-		for (int32 ComponentIndex = 0; ComponentIndex < LightComponents.Num(); ComponentIndex++)
+		bool LightsActive = !Parent->GetDamageSystem()->HasPowerOutage();
+		for (USpotLightComponent* Component : CachedLights)
 		{
-			USpotLightComponent* Component = Cast<USpotLightComponent>(LightComponents[ComponentIndex]);
-			if (Component)
-			{
-				Component->SetActive(!Parent->GetDamageSystem()->HasPowerOutage());
-			}
+			Component->SetActive(LightsActive);
 		}
 
 		// Player ship updates
@@ -500,32 +496,87 @@ void AFlareSpacecraft::Destroyed()
 	}
 
 	// Stop lights
-	TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < LightComponents.Num(); ComponentIndex++)
+	for (USpotLightComponent* Component : CachedLights)
 	{
-		USpotLightComponent* Component = Cast<USpotLightComponent>(LightComponents[ComponentIndex]);
-		if (Component)
-		{
-			Component->SetActive(false);
-		}
+		Component->SetActive(false);
 	}
 
 	Super::Destroyed();
 
 	// Clear bombs
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedWeapons.Num(); ComponentIndex++)
 	{
-		UFlareWeapon* Weapon = Cast<UFlareWeapon>(Components[ComponentIndex]);
-		if (Weapon)
-		{
-			Weapon->ClearBombs();
-		}
+		Cast<UFlareWeapon>(CachedWeapons[ComponentIndex])->ClearBombs();
 	}
 
 	CurrentTarget = NULL;
 }
 
+void AFlareSpacecraft::Unload()
+{
+	// Release the controller, as a destroyed pawn would
+	if (GetController())
+	{
+		GetController()->UnPossess();
+	}
+
+	if (Parent && !IsPresentationMode())
+	{
+		Parent->SetActiveSpacecraft(NULL);
+	}
+
+	// Stop lights
+	for (USpotLightComponent* Component : CachedLights)
+	{
+		Component->SetActive(false);
+	}
+
+	// Stop weapons and clear bombs
+	if (WeaponsSystem)
+	{
+		WeaponsSystem->DeactivateWeapons();
+	}
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedWeapons.Num(); ComponentIndex++)
+	{
+		Cast<UFlareWeapon>(CachedWeapons[ComponentIndex])->ClearBombs();
+	}
+
+	// Detach from the dock station, Load can't do it once the navigation system is gone
+	if (NavigationSystem)
+	{
+		NavigationSystem->BreakDock();
+	}
+
+	// Clear damage effects, Load restarts them for destroyed components
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedComponents.Num(); ComponentIndex++)
+	{
+		Cast<UFlareSpacecraftComponent>(CachedComponents[ComponentIndex])->ClearDestroyedEffects();
+	}
+
+	// Systems, state manager and pilot are rebuilt by Load
+	Parent = NULL;
+	DamageSystem = NULL;
+	NavigationSystem = NULL;
+	DockingSystem = NULL;
+	WeaponsSystem = NULL;
+	StateManager = NULL;
+	Pilot = NULL;
+	ShipCockit = NULL;
+
+	// Reset gameplay state
+	CurrentTarget = NULL;
+	ManualDockingTarget = NULL;
+	IsManualDocking = false;
+	HasExitedSector = false;
+	Paused = false;
+	LoadedAndReady = false;
+	AttachedToParentActor = false;
+	TargetIndex = 0;
+	TimeSinceSelection = 0;
+	TimeSinceUncontrollable = FLT_MAX;
+	TimeToStopCached = false;
+}
+
 void AFlareSpacecraft::SetPause(bool Pause)
 {
 	if (Paused == Pause)
@@ -821,6 +872,9 @@ void AFlareSpacecraft::Load(UFlareSimulatedSpacecraft* ParentSpacecraft)
 		NavigationSystem->BreakDock();
 	}
 
+	// Build component tables before the systems read them
+	UpdateComponentCache();
+
 	// Initialize damage system
 	DamageSystem = NewObject<UFlareSpacecraftDamageSystem>(this, UFlareSpacecraftDamageSystem::StaticClass());
 	DamageSystem->Initialize(this, &GetData());
@@ -844,10 +898,9 @@ void AFlareSpacecraft::Load(UFlareSimulatedSpacecraft* ParentSpacecraft)
 	UpdateDynamicComponents();
 
 	// Initialize components
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedComponents.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
+		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(CachedComponents[ComponentIndex]);
 		FFlareSpacecraftComponentSave* ComponentData = NULL;
 
 		// Find component the corresponding component data comparing the slot id
@@ -946,10 +999,9 @@ void AFlareSpacecraft::Save()
 	}
 
 	// Save all components datas
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedComponents.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
+		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(CachedComponents[ComponentIndex]);
 		Component->Save();
 	}
 }
@@ -1147,6 +1199,39 @@ void AFlareSpacecraft::UpdateDynamicComponents()
 			}
 		}
 	}
+
+	UpdateComponentCache();
+}
+
+void AFlareSpacecraft::UpdateComponentCache()
+{
+	CachedComponents = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+
+	CachedEngines.Reset();
+	CachedWeapons.Reset();
+	CachedInternalComponents.Reset();
+	for (UActorComponent* Component : CachedComponents)
+	{
+		if (Component->IsA(UFlareEngine::StaticClass()))
+		{
+			CachedEngines.Add(Component);
+		}
+		else if (Component->IsA(UFlareWeapon::StaticClass()))
+		{
+			CachedWeapons.Add(Component);
+		}
+		else if (Component->IsA(UFlareInternalComponent::StaticClass()))
+		{
+			CachedInternalComponents.Add(Cast<UFlareInternalComponent>(Component));
+		}
+	}
+
+	CachedLights.Reset();
+	TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
+	for (UActorComponent* Component : LightComponents)
+	{
+		CachedLights.Add(Cast<USpotLightComponent>(Component));
+	}
 }
 
 UFlareInternalComponent* AFlareSpacecraft::GetInternalComponentAtLocation(FVector Location) const
@@ -1154,11 +1239,8 @@ UFlareInternalComponent* AFlareSpacecraft::GetInternalComponentAtLocation(FVecto
 	float MinDistance = 100000; // 1km
 	UFlareInternalComponent* ClosestComponent = NULL;
 
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareInternalComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (UFlareInternalComponent* InternalComponent : CachedInternalComponents)
 	{
-		UFlareInternalComponent* InternalComponent = Cast<UFlareInternalComponent>(Components[ComponentIndex]);
-
 		FVector ComponentLocation;
 		float ComponentSize;
 		InternalComponent->GetBoundingSphere(ComponentLocation, ComponentSize);
@@ -1209,16 +1291,11 @@ void AFlareSpacecraft::UpdateCustomization()
 	}
 
 	// Customize lights
-	TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < LightComponents.Num(); ComponentIndex++)
+	for (USpotLightComponent* Component : CachedLights)
 	{
-		USpotLightComponent* Component = Cast<USpotLightComponent>(LightComponents[ComponentIndex]);
-		if (Component)
-		{
-			FLinearColor LightColor = UFlareSpacecraftComponent::NormalizeColor(Company->GetLightColor());
-			LightColor = LightColor.Desaturate(0.5);
-			Component->SetLightColor(LightColor);
-		}
+		FLinearColor LightColor = UFlareSpacecraftComponent::NormalizeColor(Company->GetLightColor());
+		LightColor = LightColor.Desaturate(0.5);
+		Component->SetLightColor(LightColor);
 	}
 
 	// Customize decal materials
@@ -1305,10 +1382,9 @@ void AFlareSpacecraft::DrawShipName(UCanvas* TargetCanvas, int32 Width, int32 He
 
 void AFlareSpacecraft::OnRepaired()
 {
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedComponents.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
+		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(CachedComponents[ComponentIndex]);
 		Component->OnRepaired();
 	}
 }
@@ -1316,16 +1392,9 @@ void AFlareSpacecraft::OnRepaired()
 void AFlareSpacecraft::OnRefilled()
 {
 	// Reload and repair
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < CachedWeapons.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
-
-		UFlareWeapon* Weapon = Cast<UFlareWeapon>(Components[ComponentIndex]);
-		if (Weapon)
-		{
-			Weapon->OnRefilled();
-		}
+		Cast<UFlareWeapon>(CachedWeapons[ComponentIndex])->OnRefilled();
 	}
 }
 
@@ -2030,10 +2099,7 @@ float AFlareSpacecraft::GetTimeToStop() const
 	{
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = GetComponentsByClass(UFlareEngine::StaticClass());
-
-		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / GetSpacecraftMass();
+		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(CachedEngines, CurrentVelocityAxis, false) / GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, CurrentVelocityAxis));
 
 		TimeToStopCache = (CurrentVelocity.Size() / (AccelerationInAngleAxis));
@@ -13,6 +13,8 @@
 
 class UFlareShipPilot;
 class AFlareSpacecraft;
+class UFlareInternalComponent;
+class USpotLightComponent;
 
 class UCanvasRenderTarget2D;
 
@@ -112,6 +114,9 @@ public:
 
 	virtual void Save();
 
+	/** Drop the spacecraft state so that the actor can be loaded again for another spacecraft */
+	virtual void Unload();
+
 	virtual void SetOwnerCompany(UFlareCompany* Company);
 	
 	virtual UFlareInternalComponent* GetInternalComponentAtLocation(FVector Location) const;
@@ -134,6 +139,9 @@ public:
 	void ApplyAsteroidData();
 
 	void UpdateDynamicComponents();
+
+	/** Rebuild the component tables after the component set or attachments changed */
+	void UpdateComponentCache();
 	
 	UFlareSimulatedSector* GetOwnerSector();
 	
@@ -361,6 +369,29 @@ protected:
 	mutable bool TimeToStopCached = false;
 	mutable float TimeToStopCache;
 
+
+	/*----------------------------------------------------
+		Component tables
+	----------------------------------------------------*/
+
+	// All spacecraft components
+	UPROPERTY()
+	TArray<UActorComponent*>                       CachedComponents;
+
+	// Engines, including RCS
+	UPROPERTY()
+	TArray<UActorComponent*>                       CachedEngines;
+
+	// Weapons, including turrets
+	UPROPERTY()
+	TArray<UActorComponent*>                       CachedWeapons;
+
+	UPROPERTY()
+	TArray<UFlareInternalComponent*>               CachedInternalComponents;
+
+	UPROPERTY()
+	TArray<USpotLightComponent*>                   CachedLights;
+
 public:
 
 	/*----------------------------------------------------
@@ -379,6 +410,34 @@ public:
 
 	float GetTimeToStop() const;
 
+	/** Get all spacecraft components, built in Load */
+	inline const TArray<UActorComponent*>& GetSpacecraftComponents() const
+	{
+		return CachedComponents;
+	}
+
+	/** Get engine components, built in Load */
+	inline const TArray<UActorComponent*>& GetEngines() const
+	{
+		return CachedEngines;
+	}
+
+	/** Get weapon components, built in Load */
+	inline const TArray<UActorComponent*>& GetWeapons() const
+	{
+		return CachedWeapons;
+	}
+
+	inline const TArray<UFlareInternalComponent*>& GetInternalComponents() const
+	{
+		return CachedInternalComponents;
+	}
+
+	inline const TArray<USpotLightComponent*>& GetLights() const
+	{
+		return CachedLights;
+	}
+
 	inline UFlareSimulatedSpacecraft* GetParent() const
 	{
 		return Parent;
@@ -652,6 +652,15 @@ void UFlareSpacecraftComponent::StartDestroyedEffects()
 	}
 }
 
+void UFlareSpacecraftComponent::ClearDestroyedEffects()
+{
+	if (DestroyedEffects)
+	{
+		DestroyedEffects->DestroyComponent();
+		DestroyedEffects = NULL;
+	}
+}
+
 void UFlareSpacecraftComponent::StartDamagedEffect(FVector Location, FRotator Rotation, EFlarePartSize::Type WeaponSize)
 {
 	EFlarePartSize::Type Size = EFlarePartSize::S;
@@ -455,6 +455,9 @@ public:
 	/** Create a damaged effect */
 	virtual void StartDestroyedEffects();
 
+	/** Remove the damaged effect, before the spacecraft actor is reused */
+	virtual void ClearDestroyedEffects();
+
 	/** Spawn damage effects */
 	virtual void StartDamagedEffect(FVector Location, FRotator Rotation, EFlarePartSize::Type WeaponSize);
 
@@ -491,18 +491,23 @@ struct FFlareSpacecraftSave
 	float DynamicComponentStateProgress;
 
 	/** Station current level */
+	UPROPERTY(EditAnywhere, Category = Save)
 	int32 Level;
 
 	/** Is a trade in progress */
+	UPROPERTY(EditAnywhere, Category = Save)
 	bool IsTrading;
 
 	/** Is ship intercepted */
+	UPROPERTY(EditAnywhere, Category = Save)
 	bool IsIntercepted;
 
 	/** Resource refill stock */
+	UPROPERTY(EditAnywhere, Category = Save)
 	float RepairStock;
 
 	/** Resource refill stock */
+	UPROPERTY(EditAnywhere, Category = Save)
 	float RefillStock;
 
 
@@ -519,12 +524,15 @@ struct FFlareSpacecraftSave
 	FName AttachActorName;
 	
 	/** Is a in sector reserve */
+	UPROPERTY(EditAnywhere, Category = Save)
 	bool IsReserve;
 
 	/** Allow other company to order ships */
+	UPROPERTY(EditAnywhere, Category = Save)
 	bool AllowExternalOrder;
 
 	/** List of ship order */
+	UPROPERTY(EditAnywhere, Category = Save)
 	TArray<FFlareShipyardOrderSave> ShipyardOrderQueue;
 };
 
@@ -6,6 +6,7 @@
 #include "FlareShell.h"
 #include "FlareBomb.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareActorPool.h"
 #include "../Player/FlarePlayerController.h"
 #include "Engine/StaticMeshSocket.h"
 
@@ -300,8 +301,7 @@ bool UFlareWeapon::FireGun(int GunIndex)
 	FVector FiringVelocity = Spacecraft->Airframe->GetPhysicsLinearVelocity();
 
 	// Create a shell
-	AFlareShell* Shell = GetWorld()->SpawnActor<AFlareShell>(
-		AFlareShell::StaticClass(),
+	AFlareShell* Shell = Spacecraft->GetGame()->GetActorPool()->AcquireShell(
 		FiringLocation,
 		FRotator::ZeroRotator,
 		ProjectileSpawnParams);
@@ -492,7 +492,7 @@ void UFlareWeapon::FillBombs()
 		FActorSpawnParameters Params;
 		Params.bNoFail = true;
 
-		AFlareBomb* Bomb = GetWorld()->SpawnActor<AFlareBomb>(AFlareBomb::StaticClass(), BombLocation, Rotation.Rotator(), Params);
+		AFlareBomb* Bomb = Spacecraft->GetGame()->GetActorPool()->AcquireBomb(BombLocation, Rotation.Rotator(), Params);
 		Bomb->AttachToActor(Spacecraft, FAttachmentTransformRules(EAttachmentRule::KeepWorld, true), NAME_None);
 		Bomb->Initialize(NULL, this);
 
@@ -510,9 +510,19 @@ void UFlareWeapon::FillBombs()
 
 void UFlareWeapon::ClearBombs()
 {
+	// Bombs go back to the actor pool, unless the weapon is collected with the world
+	bool CanRecycle = !HasAnyFlags(RF_BeginDestroyed);
+
 	for (int i = 0; i < Bombs.Num(); i++)
 	{
-		Bombs[i]->Destroy();
+		if (CanRecycle)
+		{
+			Bombs[i]->Recycle();
+		}
+		else
+		{
+			Bombs[i]->Destroy();
+		}
 	}
 	Bombs.Empty();
 }
@@ -688,6 +688,8 @@ void UFlareSimulatedSpacecraftDamageSystem::SetPowerDirty()
 
 void UFlareSimulatedSpacecraftDamageSystem::SetDamageDirty(FFlareSpacecraftComponentDescription* ComponentDescription)
 {
+	Spacecraft->MarkSaveDirty();
+
 	DamageDirty = true;
 	if(ComponentDescription->GeneralCharacteristics.ElectricSystem)
 	{
@@ -697,6 +699,8 @@ void UFlareSimulatedSpacecraftDamageSystem::SetDamageDirty(FFlareSpacecraftCompo
 
 void UFlareSimulatedSpacecraftDamageSystem::SetAmmoDirty()
 {
+	Spacecraft->MarkSaveDirty();
+
 	AmmoDirty = true;
 }
 
@@ -216,7 +216,7 @@ void UFlareSpacecraftDamageSystem::TickSystem(float DeltaSeconds)
 void UFlareSpacecraftDamageSystem::Initialize(AFlareSpacecraft* OwnerSpacecraft, FFlareSpacecraftSave* OwnerData)
 {
 	Spacecraft = OwnerSpacecraft;
-	Components = Spacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	Components = Spacecraft->GetSpacecraftComponents();
 	Description = Spacecraft->GetParent()->GetDescription();
 	Data = OwnerData;
 	Parent = Spacecraft->GetParent()->GetDamageSystem();
@@ -225,7 +225,7 @@ void UFlareSpacecraftDamageSystem::Initialize(AFlareSpacecraft* OwnerSpacecraft,
 void UFlareSpacecraftDamageSystem::Start()
 {
 	// Reload components
-	Components = Spacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	Components = Spacecraft->GetSpacecraftComponents();
 	Parent->TickSystem();
 
 	// Init alive status
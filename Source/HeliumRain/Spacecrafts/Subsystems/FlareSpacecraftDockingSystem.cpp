@@ -35,7 +35,7 @@ void UFlareSpacecraftDockingSystem::TickSystem(float DeltaSeconds)
 void UFlareSpacecraftDockingSystem::Initialize(AFlareSpacecraft* OwnerSpacecraft, FFlareSpacecraftSave* OwnerData)
 {
 	Spacecraft = OwnerSpacecraft;
-	Components = Spacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	Components = Spacecraft->GetSpacecraftComponents();
 	Description = Spacecraft->GetParent()->GetDescription();
 	Data = OwnerData;
 
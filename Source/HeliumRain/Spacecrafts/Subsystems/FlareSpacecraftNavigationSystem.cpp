@@ -116,7 +116,7 @@ void UFlareSpacecraftNavigationSystem::TickSystem(float DeltaSeconds)
 void UFlareSpacecraftNavigationSystem::Initialize(AFlareSpacecraft* OwnerSpacecraft, FFlareSpacecraftSave* OwnerData)
 {
 	Spacecraft = OwnerSpacecraft;
-	Components = Spacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	Components = Spacecraft->GetSpacecraftComponents();
 	Description = Spacecraft->GetParent()->GetDescription();
 	Data = OwnerData;
 
@@ -820,7 +820,7 @@ void UFlareSpacecraftNavigationSystem::ConfirmDock(AFlareSpacecraft* DockStation
 	DockConstraint->SetConstrainedComponents(Spacecraft->Airframe, NAME_None, DockStation->Airframe,NAME_None);
 
 	// Cut engines
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Spacecraft->GetEngines();
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
 		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
@@ -1018,7 +1018,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateLinearAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Spacecraft->GetEngines();
 
 	FVector DeltaPosition = (TargetLocation - Spacecraft->GetActorLocation()) / 100; // Distance in meters
 	FVector DeltaPositionDirection = DeltaPosition;
@@ -1105,7 +1105,7 @@ void UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(float DeltaSeco
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateAngularAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Spacecraft->GetEngines();
 
 	// Rotation data
 	FFlareShipCommandData Command;
@@ -1183,7 +1183,7 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetAngularVelocityToAlignAxis);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Spacecraft->GetEngines();
 
 	FVector AngularVelocity = Spacecraft->Airframe->GetPhysicsAngularVelocity();
 	FVector WorldShipAxis = Spacecraft->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
@@ -1258,7 +1258,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_Physics);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UActorComponent*>& Engines = Spacecraft->GetEngines();
 
 	if(Spacecraft->GetParent()->GetDamageSystem()->IsUncontrollable())
 	{
@@ -1399,7 +1399,7 @@ void UFlareSpacecraftNavigationSystem::UpdateCOM()
 		Getters (Attitude)
 ----------------------------------------------------*/
 
-FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const
+FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(const TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxThrustInAxis);
 
@@ -1431,7 +1431,7 @@ FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorC
 	return TotalMaxThrust;
 }
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueAxis, bool WithDamages) const
+float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(const TArray<UActorComponent*>& Engines, FVector TorqueAxis, bool WithDamages) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxTorqueInAxis);
 
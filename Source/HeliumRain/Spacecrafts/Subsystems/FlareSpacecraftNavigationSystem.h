@@ -308,7 +308,7 @@ public:
 	 * Axis : Axis of the thurst
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	FVector GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
+	FVector GetTotalMaxThrustInAxis(const TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
 
 	/**
 	 * Return the maximum torque the ship can provide in a specific axis.
@@ -316,7 +316,7 @@ public:
 	 * TorqueDirection : Axis of the torque
 	 * WithDamages : if true, use current thrust value and not theorical thrust value
 	 */
-	float GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueDirection, bool WithDamages) const;
+	float GetTotalMaxTorqueInAxis(const TArray<UActorComponent*>& Engines, FVector TorqueDirection, bool WithDamages) const;
 
 
 	/*----------------------------------------------------
@@ -181,7 +181,7 @@ void UFlareSpacecraftWeaponsSystem::TickSystem(float DeltaSeconds)
 void UFlareSpacecraftWeaponsSystem::Initialize(AFlareSpacecraft* OwnerSpacecraft, FFlareSpacecraftSave* OwnerData)
 {
 	Spacecraft = OwnerSpacecraft;
-	Components = Spacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	Components = Spacecraft->GetSpacecraftComponents();
 	Description = Spacecraft->GetParent()->GetDescription();
 	Data = OwnerData;
 }
@@ -202,7 +202,7 @@ void UFlareSpacecraftWeaponsSystem::Start()
 	}
 	WeaponGroupList.Empty();
 
-	TArray<UActorComponent*> Weapons = Spacecraft->GetComponentsByClass(UFlareWeapon::StaticClass());
+	const TArray<UActorComponent*>& Weapons = Spacecraft->GetWeapons();
 	for (int32 ComponentIndex = 0; ComponentIndex < Weapons.Num(); ComponentIndex++)
 	{
 		UFlareWeapon* Weapon = Cast<UFlareWeapon>(Weapons[ComponentIndex]);
@@ -116,7 +116,7 @@ void SFlareCargoInfo::Construct(const FArguments& InArgs)
 	{
 		return;
 	}
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 	FCHECK(Cargo);
 	PermissionButton->SetActive(Cargo->Restriction == EFlareResourceRestriction::Everybody);
 
@@ -144,7 +144,7 @@ void SFlareCargoInfo::OnMouseEnter(const FGeometry& MyGeometry, const FPointerEv
 		return;
 	}
 
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 	FCHECK(Cargo);
 
 	// Tooltip
@@ -180,7 +180,7 @@ const FSlateBrush* SFlareCargoInfo::GetResourceIcon() const
 		return NULL;
 	}
 
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 	FCHECK(Cargo);
 
 	if (Cargo->Resource)
@@ -201,7 +201,7 @@ FText SFlareCargoInfo::GetResourceAcronym() const
 		return FText();
 	}
 
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 	FCHECK(Cargo);
 
 	if (Cargo->Resource)
@@ -221,7 +221,7 @@ FText SFlareCargoInfo::GetResourceQuantity() const
 		return FText();
 	}
 
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 	FCHECK(Cargo);
 	
 	// Print IO text if any
@@ -264,7 +264,7 @@ FReply SFlareCargoInfo::OnButtonClicked()
 		return FReply::Handled();
 	}
 
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 
 	if (Cargo && Cargo->Resource && Cargo->Quantity > 0)
 	{
@@ -288,12 +288,12 @@ void SFlareCargoInfo::OnDumpConfirmed()
 	{
 		return;
 	}
-	FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
+	const FFlareCargo* Cargo = TargetSpacecraft->GetCargoBay()->GetSlot(CargoIndex);
 
 	if (Cargo && Cargo->Resource)
 	{
 		MenuManager->GetPC()->ClientPlaySound(MenuManager->GetPC()->GetSoundManager()->DeleteSound);
-		TargetSpacecraft->GetCargoBay()->DumpCargo(Cargo);
+		TargetSpacecraft->GetCargoBay()->DumpCargo(CargoIndex);
 	}
 }
 
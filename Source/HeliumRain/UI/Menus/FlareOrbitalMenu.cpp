@@ -28,7 +28,9 @@ void SFlareOrbitalMenu::Construct(const FArguments& InArgs)
 
 	// FF setup
 	FastForwardPeriod = 0.5f;
+	FastForwardDays = 7;
 	FastForwardStopRequested = false;
+	TravelTextVersion = -1;
 
 	// Build structure
 	ChildSlot
@@ -253,6 +255,8 @@ void SFlareOrbitalMenu::Enter()
 
 	// update stuff
 	StopFastForward();
+	Game->GetGameWorld()->InvalidateIncomingEvents();
+	TravelTextVersion = -1;
 	UpdateMap();
 	TradeRouteInfo->UpdateTradeRouteList();
 
@@ -305,14 +309,21 @@ void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InC
 			MenuManager->GetPC()->CheckSectorStateChanges(Sector);
 		}
 
-		// Fast forward every FastForwardPeriod
+		// Fast forward a batch of days every FastForwardPeriod, or every frame in fast fast forward
 		TimeSinceFastForward += InDeltaTime;
 		if (FastForwardActive)
 		{
-			if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward))
+			if (!FastForwardStopRequested && (UFlareGameTools::FastFastForward || TimeSinceFastForward > FastForwardPeriod))
 			{
-				MenuManager->GetGame()->GetGameWorld()->FastForward();
+				UFlareWorld* World = MenuManager->GetGame()->GetGameWorld();
+				int32 SimulatedDays = World->SimulateDays(FastForwardDays);
 				TimeSinceFastForward = 0;
+
+				// The batch stops early on incoming event changes and player-facing notifications
+				if (!UFlareGameTools::FastFastForward && SimulatedDays < FastForwardDays)
+				{
+					FastForwardStopRequested = true;
+				}
 			}
 
 			// Stop request
@@ -514,11 +525,15 @@ FText SFlareOrbitalMenu::GetTravelText() const
 		UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
 		if (GameWorld)
 		{
-			TArray<FFlareIncomingEvent> IncomingEvents = GameWorld->GetIncomingEvents();
+			const TArray<FFlareIncomingEvent>& IncomingEvents = GameWorld->GetIncomingEvents();
+			if (TravelTextVersion == GameWorld->GetIncomingEventsVersion())
+			{
+				return TravelText;
+			}
 
 			// Generate list
 			FString Result;
-			for (FFlareIncomingEvent& Event : IncomingEvents)
+			for (const FFlareIncomingEvent& Event : IncomingEvents)
 			{
 				Result += Event.Text.ToString() + "\n";
 			}
@@ -527,7 +542,9 @@ FText SFlareOrbitalMenu::GetTravelText() const
 				Result = LOCTEXT("NoTravel", "No travel.").ToString();
 			}
 
-			return FText::FromString(Result);
+			TravelText = FText::FromString(Result);
+			TravelTextVersion = GameWorld->GetIncomingEventsVersion();
+			return TravelText;
 		}
 	}
 
@@ -125,8 +125,13 @@ protected:
 	bool                                        FastForwardActive;
 	bool                                        FastForwardStopRequested;
 	float                                       FastForwardPeriod;
+	int32                                       FastForwardDays;
 	float                                       TimeSinceFastForward;
 
+	// Travel text, rebuilt when the world incoming events change
+	mutable FText                               TravelText;
+	mutable int32                               TravelTextVersion;
+
 	// Components
 	TSharedPtr<SFlarePlanetaryBox>              NemaBox;
 	TSharedPtr<SFlarePlanetaryBox>              AstaBox;
@@ -4,6 +4,7 @@
 #include "FlareWorldEconomyMenu.h"
 #include "../../Game/FlareGame.h"
 #include "../../Game/FlareSectorHelper.h"
+#include "../../Game/FlareWorldHelper.h"
 #include "../../Economy/FlareResource.h"
 #include "../../Player/FlareMenuManager.h"
 #include "../../Player/FlarePlayerController.h"
@@ -431,9 +432,9 @@ FText SFlareResourcePricesMenu::GetResourceProductionInfo(FFlareResourceDescript
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(TargetSector);
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Production, &Format));
+			FText::AsNumber(Stats[Resource->Index].Production, &Format));
 	}
 
 	return FText();
@@ -446,9 +447,9 @@ FText SFlareResourcePricesMenu::GetResourceConsumptionInfo(FFlareResourceDescrip
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(TargetSector);
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Consumption, &Format));
+			FText::AsNumber(Stats[Resource->Index].Consumption, &Format));
 	}
 
 	return FText();
@@ -458,9 +459,9 @@ FText SFlareResourcePricesMenu::GetResourceStockInfo(FFlareResourceDescription*
 {
 	if (TargetSector)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(TargetSector);
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Stock));
+			FText::AsNumber(Stats[Resource->Index].Stock));
 	}
 
 	return FText();
@@ -472,9 +473,9 @@ FText SFlareResourcePricesMenu::GetResourceCapacityInfo(FFlareResourceDescriptio
 	if (TargetSector)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(TargetSector);
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Capacity));
+			FText::AsNumber(Stats[Resource->Index].Capacity));
 	}
 
 	return FText();
@@ -748,7 +748,7 @@ void SFlareShipMenu::UpdateShipyardList()
 
 		// Iterate on production queue
 		Index = 0;
-		for (FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
+		for (const FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
 		{
 			ShipyardList->AddSlot()
 			.AutoHeight()
@@ -820,7 +820,7 @@ bool SFlareShipMenu::IsShipSSelectorDisabled() const
 {
 	if (TargetSpacecraft && TargetSpacecraft->IsShipyard())
 	{
-		for (FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
+		for (const FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
 		{
 			if (Order.Company == MenuManager->GetPC()->GetCompany()->GetIdentifier())
 			{
@@ -841,7 +841,7 @@ bool SFlareShipMenu::IsShipLSelectorDisabled() const
 {
 	if (TargetSpacecraft && TargetSpacecraft->IsShipyard())
 	{
-		for (FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
+		for (const FFlareShipyardOrderSave& Order : TargetSpacecraft->GetShipyardOrderQueue())
 		{
 			if (Order.Company == MenuManager->GetPC()->GetCompany()->GetIdentifier())
 			{
@@ -862,7 +862,7 @@ EVisibility SFlareShipMenu::GetCancelShipOrderVisibility(int32 Index) const
 {
 	if (TargetSpacecraft && TargetSpacecraft->IsShipyard() && Index < TargetSpacecraft->GetShipyardOrderQueue().Num())
 	{
-		FFlareShipyardOrderSave& Order = TargetSpacecraft->GetShipyardOrderQueue()[Index];
+		const FFlareShipyardOrderSave& Order = TargetSpacecraft->GetShipyardOrderQueue()[Index];
 
 		if (Order.Company == MenuManager->GetPC()->GetCompany()->GetIdentifier())
 		{
@@ -917,7 +917,7 @@ FText SFlareShipMenu::GetShipOrderStatus(int32 Index) const
 
 
 	UFlareSpacecraftCatalog* SpacecraftCatalog = MenuManager->GetGame()->GetSpacecraftCatalog();
-	FFlareShipyardOrderSave& Order = TargetSpacecraft->GetShipyardOrderQueue()[Index];
+	const FFlareShipyardOrderSave& Order = TargetSpacecraft->GetShipyardOrderQueue()[Index];
 
 	FFlareSpacecraftDescription* OrderDescription = SpacecraftCatalog->Get(Order.ShipClass);
 	UFlareCompany* OrderCompany = MenuManager->GetGame()->GetGameWorld()->FindCompany(Order.Company);
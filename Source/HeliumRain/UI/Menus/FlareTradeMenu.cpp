@@ -385,7 +385,7 @@ void SFlareTradeMenu::FillTradeBlock(UFlareSimulatedSpacecraft* TargetSpacecraft
 		UFlareCargoBay* SpacecraftCargoBay = TargetSpacecraft->GetCargoBay();
 		for (int32 CargoIndex = 0; CargoIndex < SpacecraftCargoBay->GetSlotCount(); CargoIndex++)
 		{
-			FFlareCargo* Cargo = SpacecraftCargoBay->GetSlot(CargoIndex);
+			const FFlareCargo* Cargo = SpacecraftCargoBay->GetSlot(CargoIndex);
 			CargoBay->AddSlot()
 			[
 				SNew(SFlareCargoInfo)
@@ -7,6 +7,7 @@
 #include "../../Game/FlareTradeRoute.h"
 #include "../../Game/FlareGame.h"
 #include "../../Game/FlareGameTools.h"
+#include "../../Game/FlareSectorHelper.h"
 #include "../../Game/FlareTradeRoute.h"
 #include "../../Player/FlareMenuManager.h"
 #include "../../Player/FlarePlayerController.h"
@@ -1295,10 +1296,12 @@ TSharedRef<SWidget> SFlareTradeRouteMenu::OnGenerateSectorComboLine(UFlareSimula
 TArray<TFlareResourceDeal> SFlareTradeRouteMenu::GetSellableResources(UFlareSimulatedSector* TargetSector) const
 {
 	TArray<TFlareResourceDeal> SellableResources;
+	FFlareSectorResourceLedger Ledger;
+	SectorHelper::ComputeResourceLedger(TargetSector, Ledger);
 
 	for (TFlareResourceDeal Deal : CurrentlyBoughtResources)
 	{
-		if (TargetSector->WantBuy(Deal.Key, MenuManager->GetPC()->GetCompany()))
+		if (Ledger.WantBuy(Deal.Key, MenuManager->GetPC()->GetCompany()))
 		{
 			int64 NewPrice = TargetSector->GetPreciseResourcePrice(Deal.Key, EFlareResourcePriceContext::Default);
 			int64 DiffPrice = NewPrice + Deal.Key->TransportFee - Deal.Value;
@@ -1317,10 +1320,12 @@ TArray<TFlareResourceDeal> SFlareTradeRouteMenu::GetSellableResources(UFlareSimu
 TArray<TFlareResourceDeal> SFlareTradeRouteMenu::GetBuyableResources(UFlareSimulatedSector* TargetSector) const
 {
 	TArray<TFlareResourceDeal> BuyableResources;
+	FFlareSectorResourceLedger Ledger;
+	SectorHelper::ComputeResourceLedger(TargetSector, Ledger);
 
 	for (TFlareResourceDeal Deal : CurrentlySoldResources)
 	{
-		if (TargetSector->WantSell(Deal.Key, MenuManager->GetPC()->GetCompany()))
+		if (Ledger.WantSell(Deal.Key, MenuManager->GetPC()->GetCompany()))
 		{
 			int64 NewPrice = TargetSector->GetPreciseResourcePrice(Deal.Key, EFlareResourcePriceContext::Default);
 			int64 DiffPrice = NewPrice - Deal.Key->TransportFee - Deal.Value;
@@ -4,6 +4,7 @@
 #include "../../Game/FlareGame.h"
 #include "../../Game/FlareGameTools.h"
 #include "../../Game/FlareSectorHelper.h"
+#include "../../Game/FlareWorldHelper.h"
 #include "../../Economy/FlareResource.h"
 #include "../../Player/FlareMenuManager.h"
 #include "../../Player/FlarePlayerController.h"
@@ -307,7 +308,7 @@ void SFlareWorldEconomyMenu::Enter(FFlareResourceDescription* Resource, UFlareSi
 	{
 		TargetResource = Resource;
 	}
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame());
+	WorldStats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetWorldStats();
 
 	// Update resource selector
 	ResourceSelector->RefreshOptions();
@@ -563,14 +564,14 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 {
 	if (TargetResource)
 	{
-		if (WorldStats.Contains(TargetResource))
+		if (WorldStats.IsValidIndex(TargetResource->Index))
 		{
 			FNumberFormattingOptions Format;
 			Format.MaximumFractionalDigits = 1;
 
 			// Balance info
 			FText BalanceText;
-			float Balance = WorldStats[TargetResource].Balance;
+			float Balance = WorldStats[TargetResource->Index].Balance;
 			if (Balance > 0)
 			{
 				BalanceText = FText::Format(LOCTEXT("BalanceInfoPlusFormat", "+{0} / day"),
@@ -585,11 +586,11 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 
 			FText Part1 = FText::Format(LOCTEXT("StockInfoFormatPart1", "\u2022Transport fee: {0} credits\n\u2022 Worldwide stock: {1}\n\u2022 Worldwide needs: {2}\n"),
 										UFlareGameTools::DisplayMoney(TargetResource->TransportFee),
-										FText::AsNumber(WorldStats[TargetResource].Stock),
-										FText::AsNumber(WorldStats[TargetResource].Capacity));
+										FText::AsNumber(WorldStats[TargetResource->Index].Stock),
+										FText::AsNumber(WorldStats[TargetResource->Index].Capacity));
 			FText Part2 = FText::Format(LOCTEXT("StockInfoFormatPart2", "\u2022 Worldwide production: {0} / day\n\u2022 Worldwide usage: {1} / day\n"),
-										FText::AsNumber(WorldStats[TargetResource].Production, &Format),
-										FText::AsNumber(WorldStats[TargetResource].Consumption, &Format));
+										FText::AsNumber(WorldStats[TargetResource->Index].Production, &Format),
+										FText::AsNumber(WorldStats[TargetResource->Index].Consumption, &Format));
 
 			// Generate info
 			return FText::Format(LOCTEXT("StockInfoFormat",
@@ -622,9 +623,9 @@ FText SFlareWorldEconomyMenu::GetResourceProductionInfo(UFlareSimulatedSector* S
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(Sector);
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Production, &Format));
+			FText::AsNumber(Stats[TargetResource->Index].Production, &Format));
 	}
 
 	return FText();
@@ -637,9 +638,9 @@ FText SFlareWorldEconomyMenu::GetResourceConsumptionInfo(UFlareSimulatedSector*
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(Sector);
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Consumption, &Format));
+			FText::AsNumber(Stats[TargetResource->Index].Consumption, &Format));
 	}
 
 	return FText();
@@ -649,9 +650,9 @@ FText SFlareWorldEconomyMenu::GetResourceStockInfo(UFlareSimulatedSector* Sector
 {
 	if (TargetResource)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(Sector);
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Stock));
+			FText::AsNumber(Stats[TargetResource->Index].Stock));
 	}
 
 	return FText();
@@ -663,9 +664,9 @@ FText SFlareWorldEconomyMenu::GetResourceCapacityInfo(UFlareSimulatedSector* Sec
 	if (TargetResource)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector);
+		const TArray<WorldHelper::FlareResourceStats>& Stats = MenuManager->GetGame()->GetGameWorld()->GetResourceStatsCache().GetSectorStats(Sector);
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Capacity));
+			FText::AsNumber(Stats[TargetResource->Index].Capacity));
 	}
 
 	return FText();
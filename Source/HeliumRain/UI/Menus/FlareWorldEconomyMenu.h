@@ -110,7 +110,7 @@ protected:
 	// Target data
 	TWeakObjectPtr<class AFlareMenuManager>         MenuManager;
 	FFlareResourceDescription*                      TargetResource;
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
 
 	// Slate data
 	TSharedPtr<SVerticalBox>                        SectorList;
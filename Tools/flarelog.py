@@ -0,0 +1,164 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+#
+# Convert Helium Rain binary logs (Saved/SaveGames/*.flog) to CSV or JSON
+#
+# Usage : flarelog.py Combat-XXXX.flog [--format csv|json] [--event SPACECRAFT_DAMAGED] [--sector SECTOR] [--company COMPANY] [--output FILE]
+#
+import argparse
+import csv
+import datetime
+import json
+import struct
+import sys
+
+LOG_FILE_MAGIC = 0x474F4C46
+LOG_FILE_VERSION = 1
+
+LOG_RECORD_STRING = 0
+LOG_RECORD_MESSAGE = 1
+
+PARAM_STRING = 0
+PARAM_INTEGER = 1
+PARAM_FLOAT = 2
+PARAM_VECTOR3 = 3
+
+# Parameter names, as documented in FlareLogApi.h
+EVENT_PARAMS = {
+	"GAME_LOADED": [],
+	"GAME_UNLOADED": [],
+	"DAY_SIMULATED": ["date"],
+	"AI_CONSTRUCTION_STARTED": ["company", "sector", "stationDescription", "upgradedStation"],
+	"COMPANY_UNLOCK_RESEARCH": ["company", "research"],
+	"SECTOR_ACTIVATED": ["sector"],
+	"SECTOR_DEACTIVATED": ["sector"],
+	"AUTOMATIC_BATTLE_STARTED": ["sector"],
+	"AUTOMATIC_BATTLE_ENDED": ["sector"],
+	"BOMB_DROPPED": ["bombId", "sourceSpacecraft", "sourceWeapon", "bombType"],
+	"BOMB_DESTROYED": ["bombId"],
+	"SPACECRAFT_DAMAGED": ["spacecraft", "damageType", "energy", "radius", "relativeLocation", "damageCompany", "damageCauser"],
+	"SPACECRAFT_COMPONENT_DAMAGED": ["spacecraft", "componentSlot", "componentType", "energy", "effectiveEnergy", "damageType", "initialDamageRatio", "terminalDamageRatio"],
+	"SPACECRAFT_HARPOONED": ["spacecraft", "harpoonOwner"],
+}
+
+HEADER = struct.Struct("<II")
+STRING_HEADER = struct.Struct("<IH")
+MESSAGE_HEADER = struct.Struct("<qIIIB")
+INT64 = struct.Struct("<q")
+UINT32 = struct.Struct("<I")
+FLOAT = struct.Struct("<f")
+VECTOR3 = struct.Struct("<fff")
+
+
+def ticks_to_date(ticks):
+	# FDateTime ticks are 100ns intervals since 0001-01-01
+	return (datetime.datetime(1, 1, 1) + datetime.timedelta(microseconds = ticks // 10)).isoformat()
+
+
+def read_messages(path):
+	with open(path, "rb") as log_file:
+		data = log_file.read()
+
+	magic, version = HEADER.unpack_from(data, 0)
+	if magic != LOG_FILE_MAGIC or version > LOG_FILE_VERSION:
+		raise ValueError("'" + path + "' is not a supported log file")
+
+	strings = {0: ""}
+	offset = HEADER.size
+
+	while offset < len(data):
+		record_type = data[offset]
+		offset += 1
+
+		if record_type == LOG_RECORD_STRING:
+			string_id, length = STRING_HEADER.unpack_from(data, offset)
+			offset += STRING_HEADER.size
+			strings[string_id] = data[offset:offset + length].decode("utf-8")
+			offset += length
+
+		elif record_type == LOG_RECORD_MESSAGE:
+			ticks, event, sector, company, param_count = MESSAGE_HEADER.unpack_from(data, offset)
+			offset += MESSAGE_HEADER.size
+
+			params = []
+			for index in range(param_count):
+				param_type = data[offset]
+				offset += 1
+
+				if param_type == PARAM_STRING:
+					params.append(strings[UINT32.unpack_from(data, offset)[0]])
+					offset += UINT32.size
+				elif param_type == PARAM_INTEGER:
+					params.append(INT64.unpack_from(data, offset)[0])
+					offset += INT64.size
+				elif param_type == PARAM_FLOAT:
+					params.append(FLOAT.unpack_from(data, offset)[0])
+					offset += FLOAT.size
+				elif param_type == PARAM_VECTOR3:
+					params.append(list(VECTOR3.unpack_from(data, offset)))
+					offset += VECTOR3.size
+				else:
+					raise ValueError("Invalid param type " + str(param_type) + " at offset " + str(offset))
+
+			yield {
+				"date": ticks_to_date(ticks),
+				"event": strings[event],
+				"sector": strings[sector],
+				"company": strings[company],
+				"params": params
+			}
+
+		else:
+			raise ValueError("Invalid record type " + str(record_type) + " at offset " + str(offset))
+
+
+def named_params(message):
+	names = EVENT_PARAMS.get(message["event"], [])
+	result = {}
+	for index, value in enumerate(message["params"]):
+		name = names[index] if index < len(names) else "param" + str(index)
+		result[name] = value
+	return result
+
+
+def main():
+	parser = argparse.ArgumentParser(description = "Convert a Helium Rain binary log to CSV or JSON")
+	parser.add_argument("log", help = "binary log file (.flog)")
+	parser.add_argument("--format", choices = ["csv", "json"], default = "csv")
+	parser.add_argument("--event", action = "append", help = "only keep this event, can be repeated")
+	parser.add_argument("--sector", help = "only keep the events happening in this sector")
+	parser.add_argument("--company", help = "only keep the events involving this company")
+	parser.add_argument("--output", help = "output file, standard output by default")
+	args = parser.parse_args()
+
+	messages = []
+	for message in read_messages(args.log):
+		if args.event and message["event"] not in args.event:
+			continue
+		if args.sector and message["sector"] != args.sector:
+			continue
+		if args.company and message["company"] != args.company:
+			continue
+		messages.append(message)
+
+	output = open(args.output, "w", newline = "", encoding = "utf-8") if args.output else sys.stdout
+
+	if args.format == "json":
+		for message in messages:
+			message["params"] = named_params(message)
+		json.dump(messages, output, indent = 1)
+		output.write("\n")
+
+	else:
+		writer = csv.writer(output)
+		writer.writerow(["date", "event", "sector", "company", "params"])
+		for message in messages:
+			params = [" ".join(str(value) for value in param) if isinstance(param, list) else param for param in message["params"]]
+			writer.writerow([message["date"], message["event"], message["sector"], message["company"]] + params)
+
+	if args.output:
+		output.close()
+
+
+if __name__ == "__main__":
+	main()